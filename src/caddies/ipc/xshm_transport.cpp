@@ -0,0 +1,521 @@
+#include "xshm_transport.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <atomic>
+#include <new>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#define XSHM_POSIX
+#endif
+
+#include "logger.h"
+
+namespace ipc {
+
+#if defined(XSHM_POSIX)
+
+    namespace {
+
+        static_assert(ATOMIC_INT_LOCK_FREE == 2, "shared memory barriers need lock-free atomics");
+
+        // start of the control segment, followed by counts[numRanks][numRanks] (connect) and
+        // reduce[2][numRanks][MAX_REDUCE] (allReduce)
+        struct Control {
+            std::atomic<int>    arrived;
+            std::atomic<int>    generation;
+            std::atomic<int>    aborted;
+            int                 numRanks;
+            char                padding[48];
+        };
+
+        size_t controlBytes(int numRanks)
+        {
+            size_t n = static_cast<size_t>(numRanks);
+            return sizeof(Control) + n * n * sizeof(uint64_t) + 2 * n * ShmTransport::MAX_REDUCE * sizeof(double);
+        }
+
+        uint64_t* countsOf(void* control)
+        {
+            return reinterpret_cast<uint64_t*>(static_cast<char*>(control) + sizeof(Control));
+        }
+
+        double* reduceOf(void* control, int numRanks)
+        {
+            return reinterpret_cast<double*>(countsOf(control) + static_cast<size_t>(numRanks) * numRanks);
+        }
+
+        // maps an existing segment, returns nullptr on failure
+        void* mapSegment(const std::string& name, size_t bytes)
+        {
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd < 0) {
+                LOGGER_E("failed to open shared memory '%s'\n", name.c_str());
+                return nullptr;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != bytes) {
+                LOGGER_E("shared memory '%s' has an unexpected size\n", name.c_str());
+                ::close(fd);
+                return nullptr;
+            }
+            void* addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            return addr == MAP_FAILED ? nullptr : addr;
+        }
+
+        // creates a zero-filled segment, returns false on failure
+        bool createSegment(const std::string& name, size_t bytes)
+        {
+            ::shm_unlink(name.c_str());
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                LOGGER_E("failed to create shared memory '%s'\n", name.c_str());
+                return false;
+            }
+            bool ok = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0;
+            ::close(fd);
+            if (!ok) {
+                LOGGER_E("failed to reserve %zu bytes of shared memory '%s'\n", bytes, name.c_str());
+                ::shm_unlink(name.c_str());
+            }
+            return ok;
+        }
+
+    } // namespace
+
+    ShmTransport::ShmTransport()
+        : mControl(nullptr), mControlBytes(0), mName(), mRank(0), mNumRanks(1), mTimeoutMs(0), mReduceSequence(0), mChannels()
+    {
+        ;
+    }
+
+    ShmTransport::~ShmTransport()
+    {
+        deinit();
+    }
+
+    std::string ShmTransport::uniqueName(const std::string& prefix)
+    {
+        static std::atomic<int> counter(0);
+        return "/" + prefix + "." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+    }
+
+    int ShmTransport::create(const std::string& name, int numRanks)
+    {
+        ASSERTER_WITH_RET(numRanks > 0, ERROR_INVALID_PARAMETER);
+        const size_t bytes = controlBytes(numRanks);
+        ASSERTER_WITH_RET(createSegment(name, bytes), ERROR_OPEN_FAILED);
+        void* addr = mapSegment(name, bytes);
+        ASSERTER_WITH_RET(addr != nullptr, ERROR_OPEN_FAILED);
+        Control* control = new (addr) Control();
+        control->arrived.store(0);
+        control->generation.store(0);
+        control->aborted.store(0);
+        control->numRanks = numRanks;
+        ::munmap(addr, bytes);
+        return NO_ERROR;
+    }
+
+    void ShmTransport::destroy(const std::string& name)
+    {
+        ::shm_unlink(name.c_str());
+    }
+
+    int ShmTransport::init(const std::string& name, int rank, int numRanks, int timeoutMs)
+    {
+        deinit();
+        ASSERTER_WITH_RET(rank >= 0 && rank < numRanks && timeoutMs > 0, ERROR_INVALID_PARAMETER);
+
+        const size_t bytes = controlBytes(numRanks);
+        void* addr = mapSegment(name, bytes);
+        ASSERTER_WITH_RET(addr != nullptr, ERROR_OPEN_FAILED);
+        if (static_cast<Control*>(addr)->numRanks != numRanks) {
+            static_cast<Control*>(addr)->aborted.store(1, std::memory_order_release);
+            ::munmap(addr, bytes);
+            ASSERTER_WITH_INFO(false, ERROR_INVALID_PARAMETER, "shared memory '%s' is not a group of %d ranks", name.c_str(), numRanks);
+        }
+
+        mControl = addr;
+        mControlBytes = bytes;
+        mName = name;
+        mRank = rank;
+        mNumRanks = numRanks;
+        mTimeoutMs = timeoutMs;
+        mReduceSequence = 0;
+
+        int retBarrier = barrier();
+        if (retBarrier != NO_ERROR) {
+            abort();
+        }
+        ASSERTER_WITH_RET(retBarrier == NO_ERROR, retBarrier);
+        if (mRank == 0) {
+            destroy(mName);
+        }
+        return NO_ERROR;
+    }
+
+    void ShmTransport::deinit()
+    {
+        for (Channel& channel : mChannels) {
+            if (channel.base != nullptr) {
+                ::munmap(channel.base, channel.bytes);
+            }
+        }
+        mChannels.clear();
+        if (mControl != nullptr) {
+            ::munmap(mControl, mControlBytes);
+        }
+        mControl = nullptr;
+        mControlBytes = 0;
+        mRank = 0;
+        mNumRanks = 1;
+    }
+
+    void ShmTransport::abort()
+    {
+        if (mControl != nullptr) {
+            static_cast<Control*>(mControl)->aborted.store(1, std::memory_order_release);
+        }
+    }
+
+    void ShmTransport::abortGroup(const std::string& name)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        void* addr = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Control)) {
+            addr = ::mmap(nullptr, sizeof(Control), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (addr != MAP_FAILED) {
+            static_cast<Control*>(addr)->aborted.store(1, std::memory_order_release);
+            ::munmap(addr, sizeof(Control));
+        }
+    }
+
+    int ShmTransport::barrier()
+    {
+        if (mNumRanks == 1) {
+            return NO_ERROR;
+        }
+        ASSERTER_WITH_RET(mControl != nullptr, ERROR_INVALID_HANDLE);
+        Control* control = static_cast<Control*>(mControl);
+
+        // the last rank to arrive resets the count and starts the next generation
+        const int generation = control->generation.load(std::memory_order_acquire);
+        if (control->arrived.fetch_add(1, std::memory_order_acq_rel) == mNumRanks - 1) {
+            control->arrived.store(0, std::memory_order_relaxed);
+            control->generation.store(generation + 1, std::memory_order_release);
+            return NO_ERROR;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned spins = 0; control->generation.load(std::memory_order_acquire) == generation; ++spins) {
+            if (spins < 1024) {
+                continue;
+            }
+            std::this_thread::yield();
+            if ((spins & 1023) == 0) {
+                ASSERTER_WITH_INFO(control->aborted.load(std::memory_order_acquire) == 0, ERROR_INVALID_HANDLE,
+                    "rank %d: a peer has aborted", mRank);
+                auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+                ASSERTER_WITH_INFO(waited.count() < mTimeoutMs, ERROR_INVALID_HANDLE, "rank %d: barrier timed out", mRank);
+            }
+        }
+        return NO_ERROR;
+    }
+
+    int ShmTransport::allReduce(double* values, int count)
+    {
+        ASSERTER_WITH_RET(count >= 0 && count <= MAX_REDUCE, ERROR_INVALID_PARAMETER);
+        if (mNumRanks == 1) {
+            return NO_ERROR;
+        }
+        ASSERTER_WITH_RET(mControl != nullptr, ERROR_INVALID_HANDLE);
+
+        // alternating slots: a rank cannot overwrite a slot before every rank has read it, because the
+        // next allReduce in between ends with a barrier
+        const size_t parity = mReduceSequence++ & 1;
+        double* slots = reduceOf(mControl, mNumRanks) + parity * mNumRanks * MAX_REDUCE;
+        std::memcpy(slots + mRank * MAX_REDUCE, values, count * sizeof(double));
+
+        int retBarrier = barrier();
+        ASSERTER_WITH_RET(retBarrier == NO_ERROR, retBarrier);
+
+        for (int k = 0; k < count; ++k) {
+            double sum = 0.0;
+            for (int r = 0; r < mNumRanks; ++r) {
+                sum += slots[r * MAX_REDUCE + k];
+            }
+            values[k] = sum;
+        }
+        return NO_ERROR;
+    }
+
+    int ShmTransport::connect(const std::vector<size_t>& sendCounts, int& channel)
+    {
+        ASSERTER_WITH_RET(sendCounts.size() == static_cast<size_t>(mNumRanks) && sendCounts[mRank] == 0, ERROR_INVALID_PARAMETER);
+        const size_t n = static_cast<size_t>(mNumRanks);
+
+        Channel ch = Channel();
+        ch.sendOffset.assign(n, 0);
+        ch.sendCount.assign(sendCounts.begin(), sendCounts.end());
+        ch.recvOffset.assign(n, 0);
+        ch.recvCount.assign(n, 0);
+        if (mNumRanks > 1) {
+            ASSERTER_WITH_RET(mControl != nullptr, ERROR_INVALID_HANDLE);
+
+            // publish this rank's row of the count matrix, then every rank derives the same layout
+            uint64_t* counts = countsOf(mControl);
+            for (size_t p = 0; p < n; ++p) {
+                counts[mRank * n + p] = sendCounts[p];
+            }
+            int retBarrier = barrier();
+            ASSERTER_WITH_RET(retBarrier == NO_ERROR, retBarrier);
+            for (size_t src = 0; src < n; ++src) {
+                for (size_t dst = 0; dst < n; ++dst) {
+                    if (src == static_cast<size_t>(mRank)) {
+                        ch.sendOffset[dst] = ch.total;
+                    }
+                    if (dst == static_cast<size_t>(mRank)) {
+                        ch.recvOffset[src] = ch.total;
+                        ch.recvCount[src] = counts[src * n + dst];
+                    }
+                    ch.total += counts[src * n + dst];
+                }
+            }
+        }
+
+        // rank 0 creates the segment, the others map it, then its name is released
+        const std::string name = mName + "." + std::to_string(mChannels.size());
+        ch.bytes = 2 * ch.total * sizeof(double);
+        if (ch.bytes > 0) {
+            bool created = mRank != 0 || createSegment(name, ch.bytes);
+            if (!created) {
+                abort();
+            }
+            int retBarrier = barrier();
+            ASSERTER_WITH_RET(created && retBarrier == NO_ERROR, created ? retBarrier : ERROR_OPEN_FAILED);
+            ch.base = static_cast<double*>(mapSegment(name, ch.bytes));
+            if (ch.base == nullptr) {
+                abort();
+            }
+            retBarrier = barrier();
+            if (mRank == 0) {
+                destroy(name);
+            }
+            ASSERTER_WITH_RET(ch.base != nullptr && retBarrier == NO_ERROR, ch.base == nullptr ? ERROR_OPEN_FAILED : retBarrier);
+        }
+
+        channel = static_cast<int>(mChannels.size());
+        mChannels.push_back(ch);
+        return NO_ERROR;
+    }
+
+    int ShmTransport::exchange(int channel, const std::vector<std::vector<double>>& send, std::vector<std::vector<double>>& recv)
+    {
+        ASSERTER_WITH_RET(channel >= 0 && channel < static_cast<int>(mChannels.size()), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(send.size() == static_cast<size_t>(mNumRanks), ERROR_INVALID_PARAMETER);
+        Channel& ch = mChannels[channel];
+        recv.resize(mNumRanks);
+        if (ch.total == 0) {
+            return NO_ERROR;
+        }
+
+        // alternating copies, see allReduce()
+        double* base = ch.base + (ch.sequence++ & 1) * ch.total;
+        for (int p = 0; p < mNumRanks; ++p) {
+            ASSERTER_WITH_INFO(send[p].size() == ch.sendCount[p], ERROR_INVALID_PARAMETER,
+                "rank %d: %zu doubles for rank %d, the channel carries %zu", mRank, send[p].size(), p, ch.sendCount[p]);
+            std::memcpy(base + ch.sendOffset[p], send[p].data(), send[p].size() * sizeof(double));
+        }
+
+        int retBarrier = barrier();
+        ASSERTER_WITH_RET(retBarrier == NO_ERROR, retBarrier);
+
+        for (int p = 0; p < mNumRanks; ++p) {
+            const double* in = base + ch.recvOffset[p];
+            recv[p].assign(in, in + ch.recvCount[p]);
+        }
+        return NO_ERROR;
+    }
+
+    int runProcesses(int numProcesses, const std::function<int(int)>& body, const std::function<void()>& onFailure)
+    {
+        ASSERTER_WITH_RET(numProcesses > 0, ERROR_INVALID_PARAMETER);
+
+        // buffered output would otherwise be written once more by every child
+        std::cout.flush();
+        std::fflush(nullptr);
+
+        std::vector<pid_t> children;
+        for (int rank = 1; rank < numProcesses; ++rank) {
+            pid_t pid = ::fork();
+            if (pid == 0) {
+                int ret = body(rank);
+                std::cout.flush();
+                std::fflush(nullptr);
+                ::_exit(ret == NO_ERROR ? 0 : 1);
+            }
+            if (pid < 0) {
+                LOGGER_E("failed to start process %d of %d\n", rank, numProcesses);
+                for (pid_t child : children) {
+                    ::kill(child, SIGKILL);
+                    ::waitpid(child, nullptr, 0);
+                }
+                return ERROR_OUTOFMEMORY;
+            }
+            children.push_back(pid);
+        }
+
+        // the children are reaped while rank 0 runs, so that a failed rank stops the others at once
+        // instead of leaving them waiting in a barrier until it times out
+        std::vector<int> status(children.size(), 0);
+        std::vector<uint8_t> reaped(children.size(), 0);
+        std::vector<uint8_t> killed(children.size(), 0);
+        auto killRemaining = [&]() {
+            for (size_t k = 0; k < children.size(); ++k) {
+                if (!reaped[k] && !killed[k]) {
+                    ::kill(children[k], SIGKILL);
+                    killed[k] = 1;
+                }
+            }
+        };
+        auto reap = [&](size_t k, int options) {
+            if (reaped[k] || ::waitpid(children[k], &status[k], options) != children[k]) {
+                return false;
+            }
+            reaped[k] = 1;
+            return !WIFEXITED(status[k]) || WEXITSTATUS(status[k]) != 0;
+        };
+
+        std::atomic<bool> done(false);
+        std::thread watcher([&]() {
+            bool failed = false;
+            while (!done.load(std::memory_order_acquire) && !failed) {
+                for (size_t k = 0; k < children.size() && !failed; ++k) {
+                    failed = reap(k, WNOHANG);
+                }
+                if (!failed) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+            if (failed) {
+                killRemaining();
+                if (onFailure) {
+                    onFailure();
+                }
+            }
+        });
+
+        int ret = body(0);
+        done.store(true, std::memory_order_release);
+        watcher.join();
+        if (ret != NO_ERROR) {
+            killRemaining();
+        }
+        for (size_t k = 0; k < children.size(); ++k) {
+            reap(k, 0);
+            if (!killed[k] && (!WIFEXITED(status[k]) || WEXITSTATUS(status[k]) != 0)) {
+                LOGGER_E("process of rank %zu failed\n", k + 1);
+            }
+            if (!WIFEXITED(status[k]) || WEXITSTATUS(status[k]) != 0) {
+                ret = ret != NO_ERROR ? ret : ERROR_INVALID_HANDLE;
+            }
+        }
+        return ret;
+    }
+
+#else
+
+    ShmTransport::ShmTransport()
+        : mControl(nullptr), mControlBytes(0), mName(), mRank(0), mNumRanks(1), mTimeoutMs(0), mReduceSequence(0), mChannels()
+    {
+        ;
+    }
+
+    ShmTransport::~ShmTransport()
+    {
+        ;
+    }
+
+    std::string ShmTransport::uniqueName(const std::string& prefix)
+    {
+        return "/" + prefix;
+    }
+
+    int ShmTransport::create(const std::string&, int)
+    {
+        LOGGER_E("shared memory transport is not supported on this platform\n");
+        return ERROR_NOT_SUPPORTED;
+    }
+
+    void ShmTransport::destroy(const std::string&)
+    {
+        ;
+    }
+
+    int ShmTransport::init(const std::string&, int, int, int)
+    {
+        return ERROR_NOT_SUPPORTED;
+    }
+
+    void ShmTransport::deinit()
+    {
+        ;
+    }
+
+    void ShmTransport::abort()
+    {
+        ;
+    }
+
+    void ShmTransport::abortGroup(const std::string&)
+    {
+        ;
+    }
+
+    int ShmTransport::barrier()
+    {
+        return NO_ERROR;
+    }
+
+    int ShmTransport::allReduce(double*, int)
+    {
+        return NO_ERROR;
+    }
+
+    int ShmTransport::connect(const std::vector<size_t>&, int& channel)
+    {
+        channel = 0;
+        return NO_ERROR;
+    }
+
+    int ShmTransport::exchange(int, const std::vector<std::vector<double>>&, std::vector<std::vector<double>>& recv)
+    {
+        recv.assign(1, std::vector<double>());
+        return NO_ERROR;
+    }
+
+    int runProcesses(int numProcesses, const std::function<int(int)>& body, const std::function<void()>&)
+    {
+        ASSERTER_WITH_INFO(numProcesses == 1, ERROR_NOT_SUPPORTED, "multiple processes are not supported on this platform");
+        return body(0);
+    }
+
+#endif
+
+} // namespace ipc
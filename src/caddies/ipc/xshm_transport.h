@@ -0,0 +1,141 @@
+#ifndef __XSHM_TRANSPORT_H__
+#define __XSHM_TRANSPORT_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace ipc
+{
+
+    /**
+     * Transports move doubles between the ranks of a fixed group. Every operation below is collective:
+     * all ranks call it in the same order. A transport provides
+     *   int rank() const, int numRanks() const,
+     *   int barrier(),
+     *   int allReduce(double* values, int count)     sums values over the ranks, adding in rank order so
+     *                                                every rank gets the same bits,
+     *   int connect(sendCounts, int& channel)        sets up a channel on which this rank sends
+     *                                                sendCounts[peer] doubles to each peer per exchange,
+     *   int exchange(channel, send, recv)            sends send[peer] and receives recv[peer] (resized to
+     *                                                what the peer sends) on a channel.
+     * Users take the transport as a template parameter, so a cluster transport only has to provide the
+     * same members.
+     */
+
+    // the group of a single process: nothing to send, reductions are the identity
+    class LocalTransport {
+    public:
+        int rank() const { return 0; }
+        int numRanks() const { return 1; }
+
+        int barrier() { return NO_ERROR; }
+
+        int allReduce(double*, int) { return NO_ERROR; }
+
+        int connect(const std::vector<size_t>&, int& channel)
+        {
+            channel = 0;
+            return NO_ERROR;
+        }
+
+        int exchange(int, const std::vector<std::vector<double>>&, std::vector<std::vector<double>>& recv)
+        {
+            recv.assign(1, std::vector<double>());
+            return NO_ERROR;
+        }
+    };
+
+    /**
+     * @brief transport between processes on one machine through posix shared memory
+     *
+     * The group is created once with create() (before the ranks start), then every rank calls init().
+     * Each channel is one shared segment holding a mailbox per (sender, receiver) pair, double buffered:
+     * exchange() writes the outgoing mailboxes, waits on a barrier and reads the incoming ones, so one
+     * barrier per exchange is enough. Segments are unlinked as soon as every rank has mapped them and
+     * disappear with the processes.
+     */
+    class ShmTransport {
+    public:
+        static const int MAX_REDUCE = 8;    // doubles per allReduce()
+
+        ShmTransport();
+        ~ShmTransport();
+
+        ShmTransport(const ShmTransport&) = delete;
+        ShmTransport& operator=(const ShmTransport&) = delete;
+
+        // a segment name unique to this process, e.g. "/caep.1234.0"
+        static std::string uniqueName(const std::string& prefix);
+
+        // creates the control segment of a group of 'numRanks' ranks (a stale segment of the same name is removed)
+        static int create(const std::string& name, int numRanks);
+
+        // removes the control segment if init() has not done it yet
+        static void destroy(const std::string& name);
+
+        /**
+         * @brief joins the group as 'rank', returns once all ranks have joined
+         *
+         * A failure after the control segment has been mapped aborts the group, so the peers do not wait for this rank.
+         *
+         * @param timeoutMs a barrier waiting longer than this fails (a peer has died or hangs)
+         */
+        int init(const std::string& name, int rank, int numRanks, int timeoutMs = 600000);
+
+        void deinit();
+
+        // tells the peers to give up: their pending and later collectives fail instead of waiting
+        void abort();
+
+        // the same for the group 'name' while some rank has not joined it yet (the control segment is removed once all have)
+        static void abortGroup(const std::string& name);
+
+        int rank() const { return mRank; }
+        int numRanks() const { return mNumRanks; }
+
+        int barrier();
+
+        int allReduce(double* values, int count);
+
+        int connect(const std::vector<size_t>& sendCounts, int& channel);
+
+        int exchange(int channel, const std::vector<std::vector<double>>& send, std::vector<std::vector<double>>& recv);
+
+    private:
+        struct Channel {
+            double*             base;       // two copies of all mailboxes
+            size_t              bytes;
+            size_t              total;      // doubles in one copy
+            std::vector<size_t> sendOffset; // by peer, within one copy
+            std::vector<size_t> sendCount;
+            std::vector<size_t> recvOffset;
+            std::vector<size_t> recvCount;
+            unsigned            sequence;   // exchanges so far, selects the copy
+        };
+
+        void*                   mControl;
+        size_t                  mControlBytes;
+        std::string             mName;
+        int                     mRank;
+        int                     mNumRanks;
+        int                     mTimeoutMs;
+        unsigned                mReduceSequence;
+        std::vector<Channel>    mChannels;
+    };
+
+    /**
+     * @brief runs body(rank) for rank 0 .. numProcesses - 1, rank 0 in the calling process and the others
+     *        in forked child processes (posix only)
+     *
+     * As soon as a rank fails the remaining child processes are killed, and onFailure (if any) is called from
+     * another thread of the calling process to stop rank 0, e.g. by aborting its transport group.
+     *
+     * @return NO_ERROR if every body returned NO_ERROR, otherwise the error of rank 0 or ERROR_INVALID_HANDLE
+     */
+    int runProcesses(int numProcesses, const std::function<int(int)>& body, const std::function<void()>& onFailure = nullptr);
+
+} // namespace ipc
+
+#endif // __XSHM_TRANSPORT_H__
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "xshm_transport.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    // rank r sends r * 100 + peer + k (k < peer + 1) to every peer, then sums (rank, 1) over the group
+    int exchangeRound(ipc::ShmTransport& transport, int channel)
+    {
+        const int rank = transport.rank(), ranks = transport.numRanks();
+        std::vector<std::vector<double>> send(ranks), recv;
+        for (int p = 0; p < ranks; ++p) {
+            for (int k = 0; p != rank && k < p + 1; ++k) {
+                send[p].push_back(rank * 100 + p + k);
+            }
+        }
+        if (transport.exchange(channel, send, recv) != NO_ERROR || static_cast<int>(recv.size()) != ranks) {
+            return ERROR_INVALID_HANDLE;
+        }
+        for (int p = 0; p < ranks; ++p) {
+            size_t expected = p == rank ? 0 : rank + 1;
+            if (recv[p].size() != expected) {
+                return ERROR_INVALID_PARAMETER;
+            }
+            for (size_t k = 0; k < recv[p].size(); ++k) {
+                if (recv[p][k] != p * 100 + rank + k) {
+                    return ERROR_INVALID_PARAMETER;
+                }
+            }
+        }
+
+        double sums[2] = {static_cast<double>(rank), 1.0};
+        if (transport.allReduce(sums, 2) != NO_ERROR) {
+            return ERROR_INVALID_HANDLE;
+        }
+        return sums[0] == ranks * (ranks - 1) / 2 && sums[1] == ranks ? NO_ERROR : ERROR_INVALID_PARAMETER;
+    }
+
+} // namespace
+
+TEST(ShmTransport, ExchangeAndReduce)
+{
+    const int ranks = 3;
+    const std::string name = ipc::ShmTransport::uniqueName("xshm-test");
+    ASSERT_EQ(ipc::ShmTransport::create(name, ranks), NO_ERROR);
+
+    int ret = ipc::runProcesses(ranks, [&](int rank) {
+        ipc::ShmTransport transport;
+        int retInit = transport.init(name, rank, ranks, 10000);
+        if (retInit != NO_ERROR) {
+            return retInit;
+        }
+        std::vector<size_t> counts(ranks);
+        for (int p = 0; p < ranks; ++p) {
+            counts[p] = p == rank ? 0 : p + 1;
+        }
+        int channel = -1;
+        int retConnect = transport.connect(counts, channel);
+        if (retConnect != NO_ERROR) {
+            return retConnect;
+        }
+        // more rounds than mailbox copies
+        for (int round = 0; round < 5; ++round) {
+            int retRound = exchangeRound(transport, channel);
+            if (retRound != NO_ERROR) {
+                return retRound;
+            }
+        }
+        return NO_ERROR;
+    });
+    EXPECT_EQ(ret, NO_ERROR);
+    ipc::ShmTransport::destroy(name);
+
+    // a rank that never joins makes the others time out
+    ASSERT_EQ(ipc::ShmTransport::create(name, 2), NO_ERROR);
+    ipc::ShmTransport transport;
+    EXPECT_NE(transport.init(name, 0, 2, 200), NO_ERROR);
+    ipc::ShmTransport::destroy(name);
+}
+
+TEST(ShmTransport, FailedRankStopsGroup)
+{
+    const int ranks = 3;
+    const std::string name = ipc::ShmTransport::uniqueName("xshm-test");
+    ASSERT_EQ(ipc::ShmTransport::create(name, ranks), NO_ERROR);
+
+    // rank 2 fails before joining: rank 1 is killed and rank 0 is aborted long before the barrier times out
+    const auto start = std::chrono::steady_clock::now();
+    int ret = ipc::runProcesses(ranks, [&](int rank) {
+        if (rank == 2) {
+            return ERROR_OPEN_FAILED;
+        }
+        ipc::ShmTransport transport;
+        return transport.init(name, rank, ranks, 600000);
+    }, [&]() {
+        ipc::ShmTransport::abortGroup(name);
+    });
+    auto waited = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_NE(ret, NO_ERROR);
+    EXPECT_LT(waited.count(), 60);
+    ipc::ShmTransport::destroy(name);
+
+    // a rank that fails after mapping the control segment aborts the group itself: rank 2 times out
+    // while rank 1 is late, rank 0 gives up without waiting for its own timeout
+    ASSERT_EQ(ipc::ShmTransport::create(name, ranks), NO_ERROR);
+    const auto restart = std::chrono::steady_clock::now();
+    ret = ipc::runProcesses(ranks, [&](int rank) {
+        if (rank == 1) {
+            std::this_thread::sleep_for(std::chrono::seconds(5));
+        }
+        ipc::ShmTransport transport;
+        return transport.init(name, rank, ranks, rank == 2 ? 200 : 600000);
+    });
+    waited = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - restart);
+    EXPECT_NE(ret, NO_ERROR);
+    EXPECT_LT(waited.count(), 60);
+    ipc::ShmTransport::destroy(name);
+}
@@ -79,6 +79,13 @@ namespace json {
         return static_cast<float>(mJson->valuedouble);
     }
 
+    double XJsonValue::getDouble() const
+    {
+        ASSERTER_WITH_RET(isValid(), cJSON_Invalid);
+        ASSERTER_WITH_RET(isNumber(), cJSON_Invalid);
+        return mJson->valuedouble;
+    }
+
     bool XJsonValue::getBool() const
     {
         ASSERTER_WITH_RET(isValid(), cJSON_Invalid);
@@ -163,6 +170,11 @@ namespace json {
         return mJsonRoot != nullptr && !cJSON_IsInvalid(mJsonRoot);
     }
 
+    bool XJson::contains(const std::string& key) const
+    {
+        return isValid() && cJSON_GetObjectItemCaseSensitive(mJsonRoot, key.c_str()) != nullptr;
+    }
+
     XJsonValue XJson::operator[](const std::string& key) const
     {
         ASSERTER_WITH_RET(isValid(), XJsonValue(nullptr));
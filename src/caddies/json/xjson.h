@@ -23,6 +23,7 @@ namespace json {
 
         int getInt() const;
         float getFloat() const;
+        double getDouble() const;
         bool getBool() const;
         std::string getString() const;
 
@@ -50,6 +51,8 @@ namespace json {
 
         bool isValid() const;
 
+        bool contains(const std::string& key) const;
+
         XJsonValue operator[](const std::string& key) const;
 
     private:
@@ -12,6 +12,7 @@ namespace memory
     public:
         XBuffer();
         XBuffer(size_t n); // n denotes the number of elements
+        XBuffer(size_t n, size_t alignment); // address aligned to alignment (power of 2) bytes, T must be trivial
         ~XBuffer();
 
         XBuffer(const XBuffer& buffer);
@@ -1,6 +1,7 @@
 #ifndef __XBUFFER_IMPL_H__
 #define __XBUFFER_IMPL_H__
 
+#include <type_traits>
 #include "xbuffer.h"
 #include "logger.h"
 
@@ -13,6 +14,18 @@ namespace memory {
         return std::shared_ptr<T>(new T[n](), std::default_delete<T[]>());
     }
 
+    template <typename T>
+    std::shared_ptr<T> makeSharedAlignedArray(size_t n, size_t alignment)
+    {
+        static_assert(std::is_trivial<T>::value, "aligned buffer only supports trivial types");
+        ASSERTER(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+        // over-allocate and round the address up, the deleter releases the original block
+        char* raw = new char[n * sizeof(T) + alignment]();
+        size_t addr = (reinterpret_cast<size_t>(raw) + alignment - 1) & ~(alignment - 1);
+        return std::shared_ptr<T>(reinterpret_cast<T*>(addr), [raw](T*) { delete[] raw; });
+    }
+
     template <typename T>
     XBuffer<T>::XBuffer()
         : mSize(0), mAddr(nullptr)
@@ -30,6 +43,16 @@ namespace memory {
         mAddr = mData.get();
     }
 
+    template <typename T>
+    XBuffer<T>::XBuffer(size_t n, size_t alignment)
+        : mSize(0), mAddr(nullptr)
+    {
+        mData = makeSharedAlignedArray<T>(n, alignment);
+        ASSERTER(mData);
+        mSize = n;
+        mAddr = mData.get();
+    }
+
     template <typename T>
     XBuffer<T>::~XBuffer()
     {
@@ -0,0 +1,141 @@
+#include "xmap_allocator.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#define XMAP_POSIX
+#endif
+
+#include "logger.h"
+
+namespace memory {
+
+#if defined(XMAP_POSIX)
+
+    namespace {
+
+        // creates and unlinks a uniquely named file, returns its descriptor or -1
+        int createUnlinkedFile(const std::string& directory)
+        {
+            std::string pattern = directory + "/xmap-XXXXXX";
+            std::vector<char> name(pattern.begin(), pattern.end());
+            name.push_back('\0');
+            int fd = ::mkstemp(name.data());
+            if (fd >= 0) {
+                ::unlink(name.data());
+            }
+            return fd;
+        }
+
+        // allocates the blocks of the file up front, so running out of space fails here instead of raising SIGBUS
+        // on a later page fault; file systems without preallocation get a sparse file. returns 0 or an errno value
+        int reserveFile(int fd, size_t bytes)
+        {
+#if defined(__APPLE__)
+            int ret = EOPNOTSUPP;
+#else
+            int ret = ::posix_fallocate(fd, 0, static_cast<off_t>(bytes));
+#endif
+            if (ret == EINVAL || ret == EOPNOTSUPP) {
+                ret = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0 ? 0 : errno;
+            }
+            return ret;
+        }
+
+        size_t pageSize()
+        {
+            static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+    } // namespace
+
+    bool isMapSupported()
+    {
+        return true;
+    }
+
+    bool isMapDirectory(const std::string& directory)
+    {
+        int fd = createUnlinkedFile(directory);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }
+
+    void* mapFile(const std::string& directory, size_t bytes)
+    {
+        int fd = createUnlinkedFile(directory);
+        if (fd < 0) {
+            LOGGER_E("failed to create a mapped file in '%s'\n", directory.c_str());
+            return nullptr;
+        }
+        int retReserve = reserveFile(fd, bytes);
+        if (retReserve != 0) {
+            LOGGER_E("failed to reserve %zu bytes in '%s': %s\n", bytes, directory.c_str(), std::strerror(retReserve));
+            ::close(fd);
+            return nullptr;
+        }
+        void* addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (addr == MAP_FAILED) {
+            LOGGER_E("failed to map %zu bytes in '%s'\n", bytes, directory.c_str());
+            return nullptr;
+        }
+        ::madvise(addr, bytes, MADV_SEQUENTIAL);
+        return addr;
+    }
+
+    void unmapFile(void* addr, size_t bytes)
+    {
+        ::munmap(addr, bytes);
+    }
+
+    void adviseWillNeed(const void* addr, size_t bytes)
+    {
+        if (addr == nullptr || bytes == 0) {
+            return;
+        }
+        size_t begin = reinterpret_cast<size_t>(addr) & ~(pageSize() - 1);
+        size_t end = reinterpret_cast<size_t>(addr) + bytes;
+        ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+    }
+
+#else
+
+    bool isMapSupported()
+    {
+        return false;
+    }
+
+    bool isMapDirectory(const std::string&)
+    {
+        return false;
+    }
+
+    void* mapFile(const std::string&, size_t)
+    {
+        LOGGER_E("memory-mapped files are not supported on this platform\n");
+        return nullptr;
+    }
+
+    void unmapFile(void*, size_t)
+    {
+        ;
+    }
+
+    void adviseWillNeed(const void*, size_t)
+    {
+        ;
+    }
+
+#endif
+
+} // namespace memory
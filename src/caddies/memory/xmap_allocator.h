@@ -0,0 +1,100 @@
+#ifndef __XMAP_ALLOCATOR_H__
+#define __XMAP_ALLOCATOR_H__
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+
+namespace memory
+{
+
+    // memory-mapped file helpers (posix only, see isMapSupported)
+    bool isMapSupported();
+
+    // true if 'directory' exists and a file can be created in it
+    bool isMapDirectory(const std::string& directory);
+
+    // creates a file of 'bytes' bytes in 'directory', maps it shared and unlinks it right away, so the
+    // space is returned when the mapping is released; the mapping is advised for sequential access.
+    // the space is reserved on the file system up front (sparse only where it cannot preallocate).
+    // returns nullptr on failure, e.g. when the file system has less than 'bytes' free
+    void* mapFile(const std::string& directory, size_t bytes);
+
+    void unmapFile(void* addr, size_t bytes);
+
+    // asks the kernel to read [addr, addr + bytes) ahead (page aligned internally), no-op for 0 bytes
+    void adviseWillNeed(const void* addr, size_t bytes);
+
+    /**
+     * @brief stl allocator backed by the heap, or by memory-mapped files when a directory is given
+     *
+     * Containers larger than RAM then page against the file system instead of failing to allocate.
+     * The allocator propagates with its container, so a container keeps the storage it was created with.
+     */
+    template <typename T>
+    class XMapAllocator {
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_copy_assignment;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        template <typename U>
+        struct rebind { typedef XMapAllocator<U> other; };
+
+        XMapAllocator() : mDirectory() {}
+        explicit XMapAllocator(const std::string& directory) : mDirectory(directory) {}
+
+        template <typename U>
+        XMapAllocator(const XMapAllocator<U>& other) : mDirectory(other.directory()) {}
+
+        T* allocate(size_t n)
+        {
+            if (n == 0) {
+                return nullptr;
+            }
+            if (mDirectory.empty()) {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+            void* addr = mapFile(mDirectory, n * sizeof(T));
+            if (addr == nullptr) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(addr);
+        }
+
+        void deallocate(T* p, size_t n)
+        {
+            if (p == nullptr) {
+                return;
+            }
+            if (mDirectory.empty()) {
+                ::operator delete(p);
+            } else {
+                unmapFile(p, n * sizeof(T));
+            }
+        }
+
+        bool isMapped() const { return !mDirectory.empty(); }
+        const std::string& directory() const { return mDirectory; }
+
+    private:
+        std::string mDirectory; // empty for heap storage
+    };
+
+    template <typename T, typename U>
+    bool operator==(const XMapAllocator<T>& a, const XMapAllocator<U>& b)
+    {
+        return a.directory() == b.directory();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const XMapAllocator<T>& a, const XMapAllocator<U>& b)
+    {
+        return !(a == b);
+    }
+
+} // namespace memory
+
+#endif // __XMAP_ALLOCATOR_H__
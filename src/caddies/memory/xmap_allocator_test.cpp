@@ -0,0 +1,58 @@
+#include <vector>
+#include <numeric>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/statvfs.h>
+#endif
+#include "xmap_allocator.h"
+#include "gtest/gtest.h"
+
+
+TEST(XMapAllocator, MappedVector)
+{
+    if (!memory::isMapSupported()) {
+        GTEST_SKIP() << "memory-mapped files not supported";
+    }
+    ASSERT_TRUE(memory::isMapDirectory("."));
+    EXPECT_FALSE(memory::isMapDirectory("./no-such-directory"));
+
+    typedef std::vector<int, memory::XMapAllocator<int>> MappedVector;
+    MappedVector mapped{memory::XMapAllocator<int>(".")};
+    EXPECT_TRUE(mapped.get_allocator().isMapped());
+
+    // growth reallocates into new mapped files, contents are preserved
+    for (int i = 0; i < 100000; ++i) {
+        mapped.push_back(i);
+    }
+    EXPECT_EQ(std::accumulate(mapped.begin(), mapped.end(), 0LL), 99999LL * 100000 / 2);
+    memory::adviseWillNeed(mapped.data() + 1000, 50000 * sizeof(int));
+
+    // copies keep the storage, assignment propagates it
+    MappedVector copy = mapped;
+    EXPECT_TRUE(copy.get_allocator().isMapped());
+    EXPECT_EQ(copy, mapped);
+
+    MappedVector heap;
+    EXPECT_FALSE(heap.get_allocator().isMapped());
+    heap = std::move(copy);
+    EXPECT_TRUE(heap.get_allocator().isMapped());
+    EXPECT_EQ(heap.size(), 100000u);
+
+    heap = MappedVector(16, 7);
+    EXPECT_FALSE(heap.get_allocator().isMapped());
+    EXPECT_EQ(heap[15], 7);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(XMapAllocator, NotEnoughSpace)
+{
+    // twice the free space of the file system: the space is reserved up front, so allocation fails
+    // (bad_alloc) instead of a page fault raising SIGBUS later
+    struct statvfs fs;
+    ASSERT_EQ(::statvfs(".", &fs), 0);
+    const size_t bytes = static_cast<size_t>(fs.f_bavail) * fs.f_frsize * 2 + (size_t(1) << 20);
+    EXPECT_EQ(memory::mapFile(".", bytes), nullptr);
+
+    memory::XMapAllocator<char> allocator(".");
+    EXPECT_THROW(allocator.allocate(bytes), std::bad_alloc);
+}
+#endif
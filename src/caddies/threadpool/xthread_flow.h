@@ -29,6 +29,12 @@ namespace framework {
 
         int init(size_t workers, size_t pipelines);
 
+        // release the threadpools, init() can be called again afterwards
+        void deinit();
+
+        bool isInited() const { return mIsInited; }
+        size_t workers() const { return mNumWorkers; }
+
         int parallelizeTiledTasks(size_t range, size_t tile, std::function<void(size_t, size_t)>&& f);
 
         template<class F, class... Args>
@@ -38,6 +44,7 @@ namespace framework {
         Flow();
 
         bool mIsInited;
+        size_t mNumWorkers;
 
         XThreadpool* mWorkers;
         XThreadpool* mPipelines;
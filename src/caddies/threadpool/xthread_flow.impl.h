@@ -10,12 +10,17 @@
 namespace framework {
 
     inline Flow::Flow()
-        : mIsInited(false), mWorkers(nullptr), mPipelines(nullptr)
+        : mIsInited(false), mNumWorkers(0), mWorkers(nullptr), mPipelines(nullptr)
     {
         ;
     }
 
     inline Flow::~Flow()
+    {
+        deinit();
+    }
+
+    inline void Flow::deinit()
     {
         if (mWorkers != nullptr) {
             delete mWorkers;
@@ -27,31 +32,35 @@ namespace framework {
             mPipelines = nullptr;
         }
 
+        mNumWorkers = 0;
         mIsInited = false;
     }
 
     inline int Flow::init(size_t workers, size_t pipelines)
     {
-        ASSERTER_WITH_INFO(mIsInited == false, ECODE_INVALID_PARAM, "threadpool already inited!");
-        ASSERTER_WITH_INFO(mWorkers == nullptr, ECODE_INVALID_PARAM, "threadpool already inited!");
-        ASSERTER_WITH_INFO(mPipelines == nullptr, ECODE_INVALID_PARAM, "threadpool already inited!");
+        ASSERTER_WITH_INFO(mIsInited == false, ERROR_INVALID_PARAMETER, "threadpool already inited!");
+        ASSERTER_WITH_INFO(mWorkers == nullptr, ERROR_INVALID_PARAMETER, "threadpool already inited!");
+        ASSERTER_WITH_INFO(mPipelines == nullptr, ERROR_INVALID_PARAMETER, "threadpool already inited!");
+        ASSERTER_WITH_INFO(workers > 0, ERROR_INVALID_PARAMETER, "threadpool needs at least one worker!");
 
         mWorkers = new XThreadpool(workers);
         mPipelines = new XThreadpool(pipelines);
 
-        ASSERTER_WITH_RET(mWorkers != nullptr, ECODE_NO_MEMORY);
-        ASSERTER_WITH_RET(mPipelines != nullptr, ECODE_NO_MEMORY);
+        ASSERTER_WITH_RET(mWorkers != nullptr, ERROR_OUTOFMEMORY);
+        ASSERTER_WITH_RET(mPipelines != nullptr, ERROR_OUTOFMEMORY);
 
+        mNumWorkers = workers;
         mIsInited = true;
 
-        return ECODE_SUCCESS;
+        return NO_ERROR;
     }
 
     inline int Flow::parallelizeTiledTasks(size_t range, size_t tile, std::function<void(size_t, size_t)>&& f)
     {
-        ASSERTER_WITH_RET(mIsInited == true, ECODE_INVALID_PARAM);
-        ASSERTER_WITH_RET(mWorkers != nullptr, ECODE_INVALID_PARAM);
-        ASSERTER_WITH_RET(mPipelines != nullptr, ECODE_INVALID_PARAM);
+        ASSERTER_WITH_RET(mIsInited == true, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(mWorkers != nullptr, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(mPipelines != nullptr, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(tile > 0, ERROR_INVALID_PARAMETER);
 
         std::vector<std::future<void>> futures;
         for (size_t i = 0; i < range; i += tile) {
@@ -62,7 +71,7 @@ namespace framework {
             it->get();
         }
 
-        return ECODE_SUCCESS;
+        return NO_ERROR;
     }
 
     template<class F, class... Args>
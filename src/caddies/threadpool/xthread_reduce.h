@@ -0,0 +1,103 @@
+#ifndef __XTHREAD_REDUCE_H__
+#define __XTHREAD_REDUCE_H__
+
+#include <cmath>
+#include <vector>
+
+#include "xthread_flow.h"
+
+
+namespace framework {
+
+    // compensated (Kahan-Babuska / Neumaier) summation, the error does not grow with the number of terms
+    class CompensatedSum {
+    public:
+        CompensatedSum() : mSum(0.0), mCompensation(0.0) {}
+
+        void add(double value)
+        {
+            double t = mSum + value;
+            if (std::abs(mSum) >= std::abs(value)) {
+                mCompensation += (mSum - t) + value;
+            } else {
+                mCompensation += (value - t) + mSum;
+            }
+            mSum = t;
+        }
+
+        void add(const CompensatedSum& other)
+        {
+            add(other.mSum);
+            mCompensation += other.mCompensation;
+        }
+
+        double result() const { return mSum + mCompensation; }
+
+    private:
+        double mSum;
+        double mCompensation;
+    };
+
+    /**
+     * @brief deterministic parallel reduction of N sums over [0, range)
+     *
+     * the range is split into tiles of a fixed size (independent of the number of workers),
+     * each tile is summed in order with CompensatedSum, the tile results are combined in tile order,
+     * so the result is bit-identical for any number of workers and any scheduling.
+     */
+    template<size_t N>
+    class DeterministicReduce {
+    public:
+        static const size_t DEFAULT_TILE = 1024;
+
+        explicit DeterministicReduce(size_t tile = DEFAULT_TILE) : mTile(tile) {}
+
+        /**
+         * @param f void(size_t i, size_t ti, CompensatedSum (&sums)[N]), adds the terms of [i, i + ti) to sums
+         * @param results the N reduced sums
+         *
+         * @return NO_ERROR if success
+         */
+        template<class F>
+        int run(size_t range, F&& f, double (&results)[N]);
+
+    private:
+        struct Partial {
+            CompensatedSum sums[N];
+        };
+
+        size_t mTile;
+        std::vector<Partial> mPartials;
+    };
+
+    template<size_t N>
+    template<class F>
+    int DeterministicReduce<N>::run(size_t range, F&& f, double (&results)[N])
+    {
+        ASSERTER_WITH_RET(mTile > 0, ERROR_INVALID_PARAMETER);
+
+        mPartials.assign((range + mTile - 1) / mTile, Partial());
+
+        const size_t tile = mTile;
+        std::vector<Partial>& partials = mPartials;
+        int ret = Flow::get().parallelizeTiledTasks(range, tile, [&] (size_t _i, size_t _ti) {
+            f(_i, _ti, partials[_i / tile].sums);
+        });
+        ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+
+        CompensatedSum total[N];
+        for (const Partial& partial : mPartials) {
+            for (size_t k = 0; k < N; ++k) {
+                total[k].add(partial.sums[k]);
+            }
+        }
+        for (size_t k = 0; k < N; ++k) {
+            results[k] = total[k].result();
+        }
+
+        return NO_ERROR;
+    }
+
+} // namespace framework
+
+#endif // __XTHREAD_REDUCE_H__
@@ -0,0 +1,83 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "xthread_reduce.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    // terms with a wide dynamic range and mixed signs, naive summation loses digits
+    std::vector<double> makeTerms(size_t n)
+    {
+        std::vector<double> terms(n);
+        std::srand(11);
+        for (size_t i = 0; i < n; ++i) {
+            double mantissa = std::rand() / (double)RAND_MAX - 0.5;
+            terms[i] = std::ldexp(mantissa, std::rand() % 60 - 30);
+        }
+        return terms;
+    }
+
+    void reduce(const std::vector<double>& terms, size_t workers, double (&results)[2])
+    {
+        framework::Flow& flow = framework::Flow::get();
+        flow.deinit();
+        ASSERT_EQ(flow.init(workers, 1), NO_ERROR);
+
+        framework::DeterministicReduce<2> reducer(100);
+        int ret = reducer.run(terms.size(), [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[2]) {
+            for (size_t i = _i; i < _i + _ti; ++i) {
+                partial[0].add(terms[i]);
+                partial[1].add(terms[i] * terms[i]);
+            }
+        }, results);
+        EXPECT_EQ(ret, NO_ERROR);
+
+        flow.deinit();
+    }
+
+} // namespace
+
+TEST(DeterministicReduce, IndependentOfWorkers)
+{
+    std::vector<double> terms = makeTerms(12345);
+
+    double reference[2];
+    reduce(terms, 1, reference);
+
+    for (size_t workers : {2, 3, 8}) {
+        double results[2];
+        reduce(terms, workers, results);
+        EXPECT_EQ(results[0], reference[0]) << workers << " workers";
+        EXPECT_EQ(results[1], reference[1]) << workers << " workers";
+    }
+}
+
+TEST(DeterministicReduce, Accuracy)
+{
+    std::vector<double> terms = makeTerms(12345);
+
+    long double exact = 0.0L;
+    for (double term : terms) {
+        exact += term;
+    }
+
+    double results[2];
+    reduce(terms, 4, results);
+    EXPECT_NEAR(results[0], (double)exact, 1e-15 * std::abs((double)exact));
+}
+
+TEST(DeterministicReduce, CompensatedSum)
+{
+    // 1 + 1e-16 * 10 is lost by naive summation
+    framework::CompensatedSum sum;
+    sum.add(1.0);
+    for (int i = 0; i < 10; ++i) {
+        sum.add(1e-16);
+    }
+    EXPECT_EQ(sum.result(), 1.0 + 1e-15);
+
+    framework::CompensatedSum empty;
+    EXPECT_EQ(empty.result(), 0.0);
+}
@@ -5,7 +5,8 @@
 #include "xthreadpool.h"
 #include "logger.h"
 
-#ifdef __unix__
+// pin workers to the big cores on android, desktop and server builds keep the default affinity
+#ifdef __ANDROID__
 #include "sched.h"
 #include "unistd.h"
 #endif
@@ -62,9 +63,9 @@ namespace framework {
 
     inline int XThreadpool::setaffinity(size_t cpu0, size_t cpu1)
     {
-#ifdef __unix__
-        cpu0 = std::max(std::min(cpu0, 7), 0);
-        cpu1 = std::max(std::min(cpu1, 7), 0);
+#ifdef __ANDROID__
+        cpu0 = std::min(cpu0, size_t(7));
+        cpu1 = std::min(cpu1, size_t(7));
 
         cpu_set_t cpuset;
 
@@ -81,6 +82,9 @@ namespace framework {
             int retSetAffinity = sched_setaffinity(pthread_gettid_np(native_thread), sizeof(cpuset), &cpuset);
             ASSERTER_WITH_RET(retSetAffinity == 0, EXIT_FAILURE);
         }
+#else
+        (void)cpu0;
+        (void)cpu1;
 #endif
 
         return EXIT_SUCCESS;
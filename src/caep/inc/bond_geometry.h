@@ -0,0 +1,117 @@
+#ifndef __BOND_GEOMETRY_H__
+#define __BOND_GEOMETRY_H__
+
+#include <vector>
+#include <string>
+#include "vec.h"
+#include "bond_table.h"
+
+
+namespace caep {
+
+    class DualHorizon;
+
+    /**
+     * @brief 键几何不变量: 只依赖参考构型与表面修正因子, 在时间积分前计算一次
+     *
+     * 按全局键编号存储:
+     * - rx, ry: 参考构型下的相对位置 coord[j] - coord[i] (三维另有 rz, 二维时为空)
+     * - idist:  参考键长
+     * - fac:    体积修正因子
+     * - coef:   bc * vol * scr * fac, 其中 scr 为方向相关的表面修正 (theta 仅用于计算 scr, 不单独保存)
+     * 粒子间距不均匀时 (Params::dual 非空) fac 与 coef 中的 bc * vol * fac 按对偶作用域计算 (见 DualHorizon).
+     *
+     * 各量均以 double 计算, 按 Real (float 或 double, 见 precision.h) 存储.
+     * 与键表相同, 可存放在内存映射文件中 (setStorage).
+     */
+    template<typename Real>
+    class BasicBondGeometry {
+    public:
+        struct Params {
+            double delta;   // 作用域半径
+            double dx;      // 粒子间距
+            double bc;      // 键常数
+            double vol;     // 粒子体积
+            const DualHorizon* dual;    // 按粒子的间距与作用域, 为空时各粒子相同
+        };
+
+        BasicBondGeometry();
+
+        /**
+         * @brief 计算所有键的不变量
+         *
+         * @param bonds 键表
+         * @param coord 粒子坐标
+         * @param fncstX x方向表面修正因子
+         * @param fncstY y方向表面修正因子
+         * @param params 材料与离散参数
+         *
+         * @return NO_ERROR if success
+         */
+        int build(const BondTable& bonds, const std::vector<Vec2>& coord,
+            const std::vector<double>& fncstX, const std::vector<double>& fncstY, const Params& params);
+
+        /**
+         * @brief 三维键几何, 表面修正 scr = 1 / |(n_x / sc_x, n_y / sc_y, n_z / sc_z)|, n 为键方向的单位向量
+         *
+         * @param fncst 各方向的表面修正因子 (大小为 3, 见 SurfaceCorrection)
+         *
+         * @return NO_ERROR if success
+         */
+        int build(const BondTable& bonds, const std::vector<Vec3>& coord,
+            const std::vector<std::vector<double>>& fncst, const Params& params);
+
+        /**
+         * @brief 存放位置, 在 build() 之前调用 (见 BondTable::setStorage)
+         */
+        void setStorage(const std::string& directory);
+
+        /**
+         * @brief 提示内核预读键 [begin, end) 的全部不变量, 存放在内存中时不做任何事
+         */
+        void prefetch(size_t begin, size_t end) const;
+
+        void clear();
+
+        size_t numBonds() const { return mIdist.size(); }
+
+        const Real* rx() const { return mRx.data(); }
+        const Real* ry() const { return mRy.data(); }
+        const Real* rz() const { return mRz.empty() ? nullptr : mRz.data(); }
+        const Real* idist() const { return mIdist.data(); }
+        const Real* fac() const { return mFac.data(); }
+        const Real* coef() const { return mCoef.data(); }
+
+        /**
+         * @brief 全部按键存储的数组, 供键表压缩 (BondTable::compact) 时随键移动
+         */
+        std::vector<Real*> fields()
+        {
+            std::vector<Real*> all = {mRx.data(), mRy.data(), mIdist.data(), mFac.data(), mCoef.data()};
+            if (!mRz.empty()) {
+                all.push_back(mRz.data());
+            }
+            return all;
+        }
+
+        size_t sizeByByte() const;
+
+        /**
+         * @brief 体积修正因子 (处理作用域边界上的粒子)
+         */
+        static double volumeCorrection(double idist, double delta, double dx);
+
+    private:
+        BondArray<Real>     mRx;
+        BondArray<Real>     mRy;
+        BondArray<Real>     mRz;
+        BondArray<Real>     mIdist;
+        BondArray<Real>     mFac;
+        BondArray<Real>     mCoef;
+    };
+
+    using BondGeometry = BasicBondGeometry<double>;
+
+} // namespace caep
+
+#endif // __BOND_GEOMETRY_H__
@@ -0,0 +1,162 @@
+#ifndef __BOND_KERNEL_H__
+#define __BOND_KERNEL_H__
+
+#include <cstddef>
+#include <cstdint>
+#include "precision.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 键力核函数的输入与输出 (均为按粒子或按键连续存储的数组)
+     *
+     * Real 为键几何的存储类型 (见 precision.h), 粒子状态始终为 double.
+     */
+    template<typename Real>
+    struct BasicBondKernelArgs {
+        // 键表
+        const size_t*   offsets;    // 粒子 i 的键从 offsets[i] 开始
+        const size_t*   ends;       // 粒子 i 参与计算的键为 [offsets[i], ends[i]) (BondTable::liveEnds)
+        const int*      neighbors;
+        uint64_t*       alive;      // 键有效位图, 断键时清除对应位
+
+        // 键几何不变量
+        const Real*     rx;
+        const Real*     ry;
+        const Real*     rz;         // 三维, 二维核函数不读取
+        const Real*     idist;
+        const Real*     fac;
+        const Real*     coef;
+
+        // 粒子状态
+        const double*   dispx;
+        const double*   dispy;
+        const double*   dispz;      // 三维
+        const uint8_t*  breakable;  // 粒子是否参与断裂判断
+
+        double          scr0;       // 临界拉伸阈值
+        double          vol;        // 粒子体积
+
+        // 输出
+        double*         forcex;
+        double*         forcey;
+        double*         forcez;     // 三维
+
+        // 损伤, 仅在断键时更新 (见 DamageTracker)
+        double*         brokenWeight;   // 已断键的 vol * fac 之和
+        const double*   refWeight;      // 全部键的 vol * fac 之和
+        double*         damage;
+        size_t*         numBroken;      // 累计断键数 (原子累加)
+    };
+
+    using BondKernelArgs = BasicBondKernelArgs<double>;
+
+    /**
+     * @brief 计算粒子 [begin, end) 的键力与断键, 有新断键的粒子同时更新损伤
+     *
+     * 键力使用断键判断前的有效状态.
+     */
+    using BondKernelFunc = void (*)(const BondKernelArgs& args, int begin, int end);
+
+    void computeBondForcesScalar(const BondKernelArgs& args, int begin, int end);
+    void computeBondForcesAvx2(const BondKernelArgs& args, int begin, int end);
+    void computeBondForcesAvx512(const BondKernelArgs& args, int begin, int end);
+
+    /**
+     * @brief 三维键力 (rz, dispz, forcez 有效), 与二维核函数共用键表、断键与损伤更新
+     *
+     * 三维粒子约有 120 条键, 有效位按 32 条键一组读取, 同一组的断键一次清除.
+     */
+    void computeBondForces3Scalar(const BondKernelArgs& args, int begin, int end);
+
+    // 精度策略 P 对应的核函数
+    template<typename P>
+    using PrecisionKernelFunc = void (*)(const BasicBondKernelArgs<typename P::Real>& args, int begin, int end);
+
+    // 混合精度: float 键几何, double 计算与累加
+    void computeBondForcesMixedScalar(const BasicBondKernelArgs<float>& args, int begin, int end);
+    void computeBondForcesMixedAvx2(const BasicBondKernelArgs<float>& args, int begin, int end);
+    void computeBondForcesMixedAvx512(const BasicBondKernelArgs<float>& args, int begin, int end);
+
+    // 单精度: float 键几何、计算与累加
+    void computeBondForcesFp32Scalar(const BasicBondKernelArgs<float>& args, int begin, int end);
+    void computeBondForcesFp32Avx2(const BasicBondKernelArgs<float>& args, int begin, int end);
+    void computeBondForcesFp32Avx512(const BasicBondKernelArgs<float>& args, int begin, int end);
+
+    class BondKernel {
+    public:
+        enum SimdLevel {
+            SCALAR = 0,
+            AVX2,
+            AVX512
+        };
+
+        /**
+         * @brief 编译器已生成且当前 CPU 支持的最高指令集 (CPUID)
+         */
+        static SimdLevel detect();
+
+        static bool isSupported(SimdLevel level);
+
+        /**
+         * @return 对应指令集的核函数, 不支持时返回标量版本
+         */
+        static BondKernelFunc select(SimdLevel level);
+
+        /**
+         * @return 精度策略 P 在对应指令集下的核函数, 不支持时返回标量版本
+         */
+        template<typename P>
+        static PrecisionKernelFunc<P> select(SimdLevel level);
+
+        static const char* name(SimdLevel level);
+    };
+
+    // 读取从键 b 开始的 n (<= 32) 个有效位
+    // 位图按粒子分块并行更新时相邻块可能共享同一个字, 读写均使用原子操作
+    inline uint32_t loadAliveBits(const uint64_t* alive, size_t b, int n)
+    {
+        size_t w = b >> 6;
+        unsigned sh = static_cast<unsigned>(b & 63);
+        uint64_t v = __atomic_load_n(alive + w, __ATOMIC_RELAXED) >> sh;
+        if (sh + n > 64) {
+            v |= __atomic_load_n(alive + w + 1, __ATOMIC_RELAXED) << (64 - sh);
+        }
+        return static_cast<uint32_t>(v & ((uint64_t(1) << n) - 1));
+    }
+
+    // 清除从键 b 开始、由 bits 指定的有效位
+    inline void clearAliveBits(uint64_t* alive, size_t b, uint32_t bits)
+    {
+        size_t w = b >> 6;
+        unsigned sh = static_cast<unsigned>(b & 63);
+        __atomic_fetch_and(alive + w, ~(uint64_t(bits) << sh), __ATOMIC_RELAXED);
+        if (sh != 0 && (uint64_t(bits) >> (64 - sh)) != 0) {
+            __atomic_fetch_and(alive + w + 1, ~(uint64_t(bits) >> (64 - sh)), __ATOMIC_RELAXED);
+        }
+    }
+
+    // 断开粒子 i 从键 b 开始、由 bits 指定的键: 清除有效位, 按键顺序累加断键权重并更新损伤
+    // 断键很少发生, 逐位处理使各核函数的结果逐位一致
+    template<typename Real>
+    inline void breakBonds(const BasicBondKernelArgs<Real>& args, int i, size_t b, uint32_t bits)
+    {
+        clearAliveBits(args.alive, b, bits);
+        __atomic_fetch_add(args.numBroken, static_cast<size_t>(__builtin_popcount(bits)), __ATOMIC_RELAXED);
+        for (; bits != 0; bits &= bits - 1) {
+            args.brokenWeight[i] += args.vol * args.fac[b + __builtin_ctz(bits)];
+        }
+        args.damage[i] = (args.refWeight[i] > 1e-10) ? args.brokenWeight[i] / args.refWeight[i] : 0.0;
+    }
+
+    template<>
+    PrecisionKernelFunc<PrecisionFp64> BondKernel::select<PrecisionFp64>(SimdLevel level);
+    template<>
+    PrecisionKernelFunc<PrecisionMixed> BondKernel::select<PrecisionMixed>(SimdLevel level);
+    template<>
+    PrecisionKernelFunc<PrecisionFp32> BondKernel::select<PrecisionFp32>(SimdLevel level);
+
+} // namespace caep
+
+#endif // __BOND_KERNEL_H__
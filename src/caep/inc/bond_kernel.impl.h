@@ -0,0 +1,101 @@
+#ifndef __BOND_KERNEL_IMPL_H__
+#define __BOND_KERNEL_IMPL_H__
+
+#include <cmath>
+#include <algorithm>
+#include "bond_kernel.h"
+
+// 逐键核函数的标量部分, 由各指令集的源文件包含 (标量版本与 SIMD 版本的尾部共用)
+
+namespace caep {
+
+    // 按 Accum 精度计算粒子 i 的键 b: 累加键力, 满足断裂条件时断键
+    template<typename Accum, typename Real>
+    static inline void computeBond(const BasicBondKernelArgs<Real>& args, int i, size_t b, bool breakable, Accum& fx, Accum& fy)
+    {
+        int cnode = args.neighbors[b];
+        Accum ux = Accum(args.rx[b]) + Accum(args.dispx[cnode] - args.dispx[i]); // 变形后相对位置
+        Accum uy = Accum(args.ry[b]) + Accum(args.dispy[cnode] - args.dispy[i]);
+        Accum nlength = std::sqrt(ux*ux + uy*uy);
+        Accum idist = Accum(args.idist[b]);
+        Accum stretch = (nlength - idist) / idist;
+
+        uint32_t alive = loadAliveBits(args.alive, b, 1);
+        if (alive && nlength > Accum(1e-10)) {
+            Accum t = Accum(args.coef[b]) * stretch / nlength;
+            fx += ux * t;
+            fy += uy * t;
+        }
+
+        // 判断是否断裂（临界拉伸+区域限制）
+        if (alive && breakable && std::abs(stretch) > Accum(args.scr0)) {
+            breakBonds(args, i, b, 1);
+        }
+    }
+
+    template<typename Accum, typename Real>
+    static inline void computeBondForces(const BasicBondKernelArgs<Real>& args, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            Accum fx = 0, fy = 0;
+            const bool breakable = args.breakable[i] != 0;
+
+            for (size_t b = args.offsets[i]; b < args.ends[i]; ++b) {
+                computeBond(args, i, b, breakable, fx, fy);
+            }
+
+            args.forcex[i] = fx;
+            args.forcey[i] = fy;
+        }
+    }
+
+    // 三维: 粒子 i 的键按 32 条一组读取有效位, 组内满足断裂条件的键在组末一次断开
+    template<typename Accum, typename Real>
+    static inline void computeBondForces3(const BasicBondKernelArgs<Real>& args, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            Accum fx = 0, fy = 0, fz = 0;
+            const bool breakable = args.breakable[i] != 0;
+            const Accum dix = Accum(args.dispx[i]), diy = Accum(args.dispy[i]), diz = Accum(args.dispz[i]);
+
+            for (size_t b0 = args.offsets[i]; b0 < args.ends[i]; b0 += 32) {
+                const int n = static_cast<int>(std::min<size_t>(32, args.ends[i] - b0));
+                const uint32_t alive = loadAliveBits(args.alive, b0, n);
+                uint32_t broken = 0;
+                for (int k = 0; k < n; ++k) {
+                    if (!((alive >> k) & 1)) {
+                        continue;
+                    }
+                    const size_t b = b0 + k;
+                    int cnode = args.neighbors[b];
+                    Accum ux = Accum(args.rx[b]) + (Accum(args.dispx[cnode]) - dix); // 变形后相对位置
+                    Accum uy = Accum(args.ry[b]) + (Accum(args.dispy[cnode]) - diy);
+                    Accum uz = Accum(args.rz[b]) + (Accum(args.dispz[cnode]) - diz);
+                    Accum nlength = std::sqrt(ux*ux + uy*uy + uz*uz);
+                    Accum idist = Accum(args.idist[b]);
+                    Accum stretch = (nlength - idist) / idist;
+
+                    if (nlength > Accum(1e-10)) {
+                        Accum t = Accum(args.coef[b]) * stretch / nlength;
+                        fx += ux * t;
+                        fy += uy * t;
+                        fz += uz * t;
+                    }
+                    if (breakable && std::abs(stretch) > Accum(args.scr0)) {
+                        broken |= uint32_t(1) << k;
+                    }
+                }
+                if (broken != 0) {
+                    breakBonds(args, i, b0, broken);
+                }
+            }
+
+            args.forcex[i] = fx;
+            args.forcey[i] = fy;
+            args.forcez[i] = fz;
+        }
+    }
+
+} // namespace caep
+
+#endif // __BOND_KERNEL_IMPL_H__
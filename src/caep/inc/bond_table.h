@@ -0,0 +1,103 @@
+#ifndef __BOND_TABLE_H__
+#define __BOND_TABLE_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "xmap_allocator.h"
+
+
+namespace caep {
+
+    // 按键存储的数组: 默认在内存中, 指定目录时存放在该目录下的内存映射文件中 (见 xmap_allocator.h)
+    template<typename T>
+    using BondArray = std::vector<T, memory::XMapAllocator<T>>;
+
+    /**
+     * @brief 键表: 按粒子分段 (CSR) 存储的有向键 (i -> j)
+     *
+     * 粒子 i 的键编号为 [begin(i), end(i)), 键编号在全局连续, 可直接索引按键存储的数组;
+     * 键的有效状态以位图存储, 1 位对应 1 条键.
+     * 参与计算的键为 [begin(i), liveEnd(i)): 压缩 (compact) 后有效键按原顺序移到前部, 断键移到 liveEnd 之后,
+     * 不再进入键循环; 断键仍保留在表中, 位图中对应位为 0.
+     * 邻居编号与有效位图可存放在内存映射文件中 (setStorage), 超过内存容量的键表按粒子分块顺序读写,
+     * prefetch() 提示内核预读下一块.
+     */
+    class BondTable {
+    public:
+        BondTable();
+
+        /**
+         * @brief 由邻域搜索结果建立键表, 所有键初始为有效
+         *
+         * @param numfam 每个粒子的邻居数量
+         * @param nodefam 按粒子连续存放的邻居列表 (移入键表, 不再复制)
+         *
+         * @return NO_ERROR if success
+         */
+        int init(const std::vector<int>& numfam, std::vector<int>&& nodefam);
+
+        /**
+         * @brief 键数据 (邻居编号、有效位图) 的存放位置, 在 init() 之前调用
+         *
+         * @param directory 为空时存放在内存中, 否则存放在该目录下的内存映射文件中 (文件随键表释放)
+         *
+         * @return NO_ERROR if success
+         */
+        int setStorage(const std::string& directory);
+        bool isMapped() const { return mNeighbors.get_allocator().isMapped(); }
+
+        /**
+         * @brief 提示内核预读粒子 [begin, end) 的键数据, 存放在内存中时不做任何事
+         */
+        void prefetch(int begin, int end) const;
+
+        void clear();
+
+        size_t numParticles() const { return mOffsets.empty() ? 0 : mOffsets.size() - 1; }
+        size_t numBonds() const { return mNeighbors.size(); }
+
+        size_t begin(int i) const { return mOffsets[i]; }
+        size_t end(int i) const { return mOffsets[i + 1]; }
+        int count(int i) const { return static_cast<int>(mOffsets[i + 1] - mOffsets[i]); }
+        size_t liveEnd(int i) const { return mLiveEnds[i]; }
+
+        int neighbor(size_t b) const { return mNeighbors[b]; }
+
+        bool isAlive(size_t b) const { return (mAlive[b >> 6] >> (b & 63)) & 1; }
+        void breakBond(size_t b) { mAlive[b >> 6] &= ~(uint64_t(1) << (b & 63)); }
+
+        const size_t* offsets() const { return mOffsets.data(); }
+        const int* neighbors() const { return mNeighbors.data(); }
+        const uint64_t* aliveMask() const { return mAlive.data(); }
+        uint64_t* aliveMask() { return mAlive.data(); }
+        const size_t* liveEnds() const { return mLiveEnds.data(); }
+
+        /**
+         * @brief 压缩粒子 [begin, end) 的参与计算区间, 断键移出 [begin(i), liveEnd(i))
+         *
+         * 有效键保持原有顺序, 按键存储的数组 fields 随键一起移动.
+         * 不同粒子区间互不重叠时可并行调用 (位图相邻区间共享的字以原子操作更新).
+         *
+         * @param fields 按键存储的数组 (float 或 double), 大小均为 numBonds()
+         *
+         * @return 本次移出参与计算区间的键数
+         */
+        template<typename T>
+        size_t compact(int begin, int end, const std::vector<T*>& fields);
+
+        size_t sizeByByte() const;
+
+    private:
+        bool isAliveAtomic(size_t b) const { return (__atomic_load_n(&mAlive[b >> 6], __ATOMIC_RELAXED) >> (b & 63)) & 1; }
+
+        std::vector<size_t>     mOffsets;   // 大小为粒子数 + 1
+        BondArray<int>          mNeighbors; // 大小为键数
+        BondArray<uint64_t>     mAlive;     // 键有效位图
+        std::vector<size_t>     mLiveEnds;  // 粒子 i 参与计算的键为 [mOffsets[i], mLiveEnds[i])
+    };
+
+} // namespace caep
+
+#endif // __BOND_TABLE_H__
@@ -1,6 +1,104 @@
 #ifndef __CAEP_H__
 #define __CAEP_H__
 
-int demo_hole();
+#include <cstddef>
+#include <vector>
 
-#endif // __CAEP_H__
\ No newline at end of file
+// 键力计算方式
+enum ForceEngine {
+    FORCE_ENGINE_BOND = 0,      // 逐键计算 (SIMD)
+    FORCE_ENGINE_HALF_BOND,     // 半键模式, 每对粒子只计算一次键力
+    FORCE_ENGINE_STENCIL        // 规则点阵模板, 非规则粒子逐键计算
+};
+
+// 浮点精度: 键几何存储 / 键力计算 (粒子状态始终为 double)
+enum Precision {
+    PRECISION_FP64 = 0,         // double / double
+    PRECISION_MIXED,            // float / double
+    PRECISION_FP32              // float / float
+};
+
+// 求解方法
+enum SolverMethod {
+    SOLVER_RELAXATION = 0,      // 自适应动态松弛 (伪时间步)
+    SOLVER_PCG,                 // 准静态: 修正牛顿迭代 + 无矩阵 Jacobi 预条件共轭梯度法
+    SOLVER_DYNAMIC              // 显式动力学: 速度 Verlet, 真实密度与稳定步长
+};
+
+// 松弛积分器 (SOLVER_RELAXATION)
+enum Integrator {
+    INTEGRATOR_ADR = 0,         // 自适应动态松弛
+    INTEGRATOR_FIRE             // Fast Inertial Relaxation Engine
+};
+
+// 断键压缩策略, 两项均为 0 时不压缩 (半键模式不支持压缩)
+struct CompactionPolicy {
+    int     interval;       // 每 interval 步压缩一次
+    double  threshold;      // 上次压缩后新断键数超过有效键数的 threshold 时压缩
+};
+
+// 收敛判断与加载步, 两个容差均为 0 时不判断收敛
+// loadSteps 为 0 时每步按边界速度推进加载 (每个加载步只迭代一次); 大于 0 时最终边界位移不变,
+// 分为 loadSteps 个加载步, 每个加载步迭代至收敛或用完 steps / loadSteps 次迭代, 最后一个加载步收敛后提前结束
+struct ConvergencePolicy {
+    int     loadSteps;      // 加载步数
+    double  forceTolerance; // 不平衡力范数 / 本加载步内的峰值
+    double  dispTolerance;  // 位移增量范数 / 位移范数
+    int     stableSteps;    // 收敛前至少连续 stableSteps 次迭代没有新断键
+};
+
+// demo_hole 的最终结果 (内部粒子, 按原粒子顺序)
+struct HoleResult {
+    std::vector<double> dispx;
+    std::vector<double> dispy;
+    std::vector<double> dispz;          // 三维 (config.dimension == 3), 二维时为空
+    std::vector<double> damage;
+    size_t              numBroken;
+    int                 iterations;     // 实际迭代次数
+};
+
+namespace caep {
+    struct SimConfig;
+}
+
+/**
+ * @brief 按运行期配置求解带孔方板 (见 sim_config.h), 缓冲区按实际粒子数分配
+ *        config.dimension 为 3 时求解孔贯穿厚度的三维厚板 (见 pd_solver.h)
+ *        config.ranks 大于 1 时按区域分解在多个本机进程中求解 (见 domain_decomposition.h)
+ *        config.refineLevels 大于 0 时孔附近粒子加密, 远处粒子逐层变粗 (对偶作用域, 见 dual_horizon.h)
+ *
+ * @param result 非空时输出最终的位移与损伤
+ */
+int demo_hole(const caep::SimConfig& config, HoleResult* result = nullptr);
+
+/**
+ * @brief 以默认问题规模运行 demo_hole
+ *
+ * @param threads 工作线程数
+ * @param engine 键力计算方式
+ * @param reorder 按 Morton 序重编号粒子 (输出仍按原顺序)
+ * @param compaction 断键压缩策略: 断键移出键循环, 损伤仍按全部键统计
+ * @param precision 浮点精度, 混合精度与单精度只支持逐键计算 (FORCE_ENGINE_BOND)
+ * @param result 非空时输出最终的位移与损伤
+ */
+int demo_hole(size_t threads = 1, ForceEngine engine = FORCE_ENGINE_BOND, bool reorder = false,
+    const CompactionPolicy& compaction = CompactionPolicy(), Precision precision = PRECISION_FP64,
+    HoleResult* result = nullptr);
+
+/**
+ * @brief 强扩展性测试: 以 config 的问题规模运行, 线程数依次取 1, 2, 4, ... maxThreads, 输出耗时、加速比与并行效率
+ */
+int scaling_hole(const caep::SimConfig& config, size_t maxThreads);
+
+/**
+ * @brief 精度测试: 以 config 的问题规模分别以 fp64、mixed、fp32 运行 demo_hole (逐键计算),
+ *        输出耗时以及位移与损伤相对 fp64 的误差
+ */
+int precision_hole(const caep::SimConfig& config);
+
+/**
+ * @brief 键循环吞吐量测试: 粒子数取 1e5, 1e6, ... maxParticles, 比较光栅顺序与 Morton 序
+ */
+int bench_reorder(size_t maxParticles);
+
+#endif // __CAEP_H__
@@ -0,0 +1,62 @@
+#ifndef __DAMAGE_TRACKER_H__
+#define __DAMAGE_TRACKER_H__
+
+#include <vector>
+#include <cstddef>
+#include "bond_table.h"
+#include "bond_kernel.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 增量损伤: 损伤 = 已断键权重 / 全部键权重, 键权重为 vol * fac
+     *
+     * 全部键权重在建立时按键顺序求和一次, 已断键权重只在断键时由核函数累加 (breakBonds),
+     * 未发生断键的粒子不再每步遍历键表统计有效键比例.
+     * 已断键权重的变化同时标记了键族发生变化的粒子 (collectChanged).
+     */
+    class DamageTracker {
+    public:
+        DamageTracker();
+
+        /**
+         * @brief 由键表当前的有效状态计算两个权重与初始损伤
+         *
+         * @param bonds 键表
+         * @param fac 按键存储的体积修正系数 (float 或 double, 与核函数读取的相同)
+         * @param vol 粒子体积
+         * @param numActive 参与断裂计算的粒子为 [0, numActive)
+         * @param damage 输出的损伤 (大小至少为 numActive)
+         *
+         * @return NO_ERROR if success
+         */
+        template<typename Real>
+        int init(const BondTable& bonds, const Real* fac, double vol, int numActive, double* damage);
+
+        void clear();
+
+        /**
+         * @brief 自上次调用 (或 init) 以来有新断键的粒子, 即已断键权重发生变化的粒子, 按编号升序追加到 changed
+         */
+        void collectChanged(std::vector<int>& changed);
+
+        const double* refWeight() const { return mRefWeight.data(); }
+        double* brokenWeight() { return mBrokenWeight.data(); }
+
+        // 累计断键数, 由 breakBonds 原子累加
+        size_t* brokenCounter() { return &mNumBroken; }
+        size_t numBroken() const { return __atomic_load_n(&mNumBroken, __ATOMIC_RELAXED); }
+
+        size_t sizeByByte() const;
+
+    private:
+        std::vector<double>     mRefWeight;     // 全部键的 vol * fac 之和
+        std::vector<double>     mBrokenWeight;  // 已断键的 vol * fac 之和
+        std::vector<double>     mSeenWeight;    // 上次 collectChanged 时的已断键权重
+        size_t                  mNumBroken;
+    };
+
+} // namespace caep
+
+#endif // __DAMAGE_TRACKER_H__
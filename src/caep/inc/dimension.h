@@ -0,0 +1,114 @@
+#ifndef __DIMENSION_H__
+#define __DIMENSION_H__
+
+#include <cmath>
+#include <vector>
+#include "vec.h"
+#include "bond_geometry.h"
+#include "bond_kernel.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 与空间维数相关的常数与运算 (PdSolver 的模板参数 Dim)
+     *
+     * 键型近场动力学的泊松比固定: 二维 (平面应力) 为 1/3, 三维为 1/4.
+     * - bondConstant: 键常数 c, 使均匀变形下的应变能密度与连续介质一致
+     * - volume: 单个粒子体积, 二维为 dx^2 * thick
+     * - horizonMeasure: 作用域的体积 (二维为 pi delta^2 thick), 用于 ADR 的质量估计
+     * - strainEnergyDensity: 单方向拉伸 s (其余应变为 0) 的连续介质应变能密度 (lambda + 2 mu) s^2 / 2
+     */
+    template<int Dim>
+    struct Dimension;
+
+    template<>
+    struct Dimension<2> {
+        typedef Vec2 Point;
+
+        // c = 9E / (pi t delta^3)
+        static double bondConstant(double E, double delta, double thick) { return 9.0 * E / (M_PI * thick * std::pow(delta, 3)); }
+        static double volume(double dx, double thick) { return dx * dx * thick; }
+        static double horizonMeasure(double delta, double thick) { return M_PI * std::pow(delta, 2) * thick; }
+        static double strainEnergyDensity(double E, double s) { return 9.0/16.0 * E * s * s; }
+
+        static Point point(const double (&c)[2]) { return {c[0], c[1]}; }
+
+        // 精度策略 P 的键力核函数 (见 precision.h)
+        template<typename P>
+        static PrecisionKernelFunc<P> kernel(BondKernel::SimdLevel level) { return BondKernel::select<P>(level); }
+        static const char* kernelName(BondKernel::SimdLevel level) { return BondKernel::name(level); }
+
+        template<typename Real>
+        static int buildGeometry(BasicBondGeometry<Real>& geometry, const BondTable& bonds, const std::vector<Point>& coord,
+            const std::vector<std::vector<double>>& fncst, const typename BasicBondGeometry<Real>::Params& params)
+        {
+            return geometry.build(bonds, coord, fncst[0], fncst[1], params);
+        }
+    };
+
+    template<>
+    struct Dimension<3> {
+        typedef Vec3 Point;
+
+        // c = 12E / (pi delta^4), 即 18K / (pi delta^4), K = 2E/3
+        static double bondConstant(double E, double delta, double /*thick*/) { return 12.0 * E / (M_PI * std::pow(delta, 4)); }
+        static double volume(double dx, double /*thick*/) { return dx * dx * dx; }
+        static double horizonMeasure(double delta, double /*thick*/) { return 4.0/3.0 * M_PI * std::pow(delta, 3); }
+        static double strainEnergyDensity(double E, double s) { return 0.6 * E * s * s; }
+
+        static Point point(const double (&c)[3]) { return {c[0], c[1], c[2]}; }
+
+        // 三维键力暂只有 fp64 标量版本 (其余精度由 SimConfig::validate 拒绝)
+        template<typename P>
+        static PrecisionKernelFunc<P> kernel(BondKernel::SimdLevel /*level*/) { return computeBondForces3Scalar; }
+        static const char* kernelName(BondKernel::SimdLevel /*level*/) { return "scalar-3d"; }
+
+        template<typename Real>
+        static int buildGeometry(BasicBondGeometry<Real>& geometry, const BondTable& bonds, const std::vector<Point>& coord,
+            const std::vector<std::vector<double>>& fncst, const typename BasicBondGeometry<Real>::Params& params)
+        {
+            return geometry.build(bonds, coord, fncst, params);
+        }
+    };
+
+    /**
+     * @brief 立方 (二维为正方) 点阵: 点 first + idx * step, idx[d] in [0, count[d]), x 方向变化最快
+     *
+     * @param keep keep(point) 为 false 的点不加入
+     */
+    template<int Dim, typename Keep>
+    void generateLattice(const double (&first)[Dim], const double (&step)[Dim], const int (&count)[Dim], Keep keep,
+        std::vector<typename VecOf<Dim>::type>& points)
+    {
+        int idx[Dim] = {};
+        for (int d = 0; d < Dim; ++d) {
+            if (count[d] <= 0) {
+                return;
+            }
+        }
+        for (;;) {
+            double c[Dim];
+            for (int d = 0; d < Dim; ++d) {
+                c[d] = first[d] + idx[d] * step[d];
+            }
+            typename VecOf<Dim>::type p = Dimension<Dim>::point(c);
+            if (keep(p)) {
+                points.push_back(p);
+            }
+
+            int d = 0;
+            while (d < Dim && idx[d] == count[d] - 1) {
+                idx[d] = 0;
+                ++d;
+            }
+            if (d == Dim) {
+                break;
+            }
+            ++idx[d];
+        }
+    }
+
+} // namespace caep
+
+#endif // __DIMENSION_H__
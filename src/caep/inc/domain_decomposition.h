@@ -0,0 +1,77 @@
+#ifndef __DOMAIN_DECOMPOSITION_H__
+#define __DOMAIN_DECOMPOSITION_H__
+
+#include <vector>
+#include "vec.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 区域分解: 按 x 坐标把粒子划分为 numRanks 个条带, 每个 rank 拥有一个条带 (内部粒子数大致相等),
+     *        并保留条带两侧宽度为 delta 的幽灵层 (其他 rank 拥有的粒子, 每步由所有者发来位移)
+     *
+     * 同一 x 坐标的粒子属于同一个 rank. 拥有的粒子的邻居都在局部粒子中, 键只属于其起点粒子的所有者,
+     * 幽灵粒子不建键, 因此每条键只在一个 rank 上计算与断开.
+     * 局部编号: 拥有的内部粒子、底部边界粒子、顶部边界粒子 (各段内保持全局顺序), 之后为幽灵粒子 (全局编号升序).
+     * 只有一个 rank 时局部编号与全局编号相同.
+     * 所有 rank 由相同的全局粒子得到一致的划分, 无需通信.
+     */
+    class DomainDecomposition {
+    public:
+        // 粒子分段: 内部 [0, numInt), 底部边界 [numInt, numBottom), 顶部边界 [numBottom, numTop)
+        struct Layout {
+            int numInt;
+            int numBottom;
+            int numTop;
+        };
+
+        DomainDecomposition();
+
+        /**
+         * @param points 全局粒子坐标 (Vec2 或 Vec3)
+         * @param layout 全局粒子分段
+         * @param delta 作用域半径 (幽灵层宽度)
+         *
+         * @return NO_ERROR if success, ERROR_INVALID_PARAMETER if some rank owns no interior particle
+         */
+        template<typename Point>
+        int init(const std::vector<Point>& points, const Layout& layout, int numRanks, int rank, double delta);
+
+        int rank() const { return mRank; }
+        int numRanks() const { return mNumRanks; }
+
+        // 拥有的粒子在局部编号中的分段
+        const Layout& local() const { return mLocal; }
+        int numLocal() const { return static_cast<int>(mGlobalIds.size()); }
+        int numGhosts() const { return numLocal() - mLocal.numTop; }
+
+        // 局部编号 -> 全局编号
+        const std::vector<int>& globalIds() const { return mGlobalIds; }
+
+        /**
+         * 每次交换发往 peer 的拥有粒子 (peer 的幽灵粒子) 与从 peer 接收的幽灵粒子 (局部编号),
+         * 两端均按全局编号升序, 发送与接收一一对应
+         */
+        const std::vector<int>& sendList(int peer) const { return mSend[peer]; }
+        const std::vector<int>& recvList(int peer) const { return mRecv[peer]; }
+
+        /**
+         * @brief 调整局部粒子的邻域搜索结果: 幽灵粒子的邻居清空, 其余粒子的邻居按全局编号排序
+         *
+         * 排序后键力、表面修正与损伤的求和顺序与不划分时相同.
+         */
+        void localizeFamilies(std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam) const;
+
+    private:
+        int                             mRank;
+        int                             mNumRanks;
+        Layout                          mLocal;
+        std::vector<int>                mGlobalIds;
+        std::vector<std::vector<int>>   mSend;
+        std::vector<std::vector<int>>   mRecv;
+    };
+
+} // namespace caep
+
+#endif // __DOMAIN_DECOMPOSITION_H__
@@ -0,0 +1,92 @@
+#ifndef __DUAL_HORIZON_H__
+#define __DUAL_HORIZON_H__
+
+#include <vector>
+#include <cstddef>
+#include "bond_table.h"
+#include "bond_geometry.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 对偶作用域 (dual-horizon) 近场动力学: 粒子间距不均匀时的按粒子离散参数
+     *
+     * 粒子 i 的间距为 dx_i, 作用域半径 delta_i = m dx_i, 体积 vol_i, 键常数 c_i = c(delta_i).
+     * 键 (i, j) 在 |xi| <= max(delta_i, delta_j) 时存在 (见 NeighborSearch 的按粒子作用域搜索), 两端的作用域各贡献一半键力:
+     *   k_ij = (c_i fac(|xi|, delta_i, dx_j) + c_j fac(|xi|, delta_j, dx_i)) / 2 * vol_j
+     * fac 为体积修正因子 (BondGeometry::volumeCorrection). k_ij vol_i = k_ji vol_j, 作用于两端的力大小相等,
+     * 粗细粒子交界处不产生伪力 (ghost force). 各粒子间距相同时 k_ij = c fac vol, 即原键型模型.
+     */
+    class DualHorizon {
+    public:
+        struct Params {
+            double  ratio;          // 作用域半径 / 粒子间距
+            double  youngModulus;   // 弹性模量
+            double  thick;          // 板厚度 (二维)
+            double  refVolume;      // 键几何中 fac 的体积基准 (核函数与损伤使用的 vol)
+            double  (*bondConstant)(double E, double delta, double thick);  // 见 Dimension
+            double  (*volume)(double dx, double thick);
+        };
+
+        DualHorizon();
+
+        /**
+         * @param spacing 各粒子的间距 (含幽灵粒子)
+         *
+         * @return NO_ERROR if success
+         */
+        int init(const std::vector<double>& spacing, const Params& params);
+
+        void clear();
+
+        bool empty() const { return mSpacing.empty(); }
+
+        double spacing(int i) const { return mSpacing[i]; }
+        double bondConstant(int i) const { return mBondConstant[i]; }
+        const std::vector<double>& horizons() const { return mHorizon; }
+
+        /**
+         * @brief 键 i -> j 的刚度 k_ij (不含表面修正), 即均匀粒子时的 bc * vol * fac
+         */
+        double stiffness(int i, int j, double idist) const
+        {
+            return 0.5 * (mBondConstant[i] * BondGeometry::volumeCorrection(idist, mHorizon[i], mSpacing[j])
+                + mBondConstant[j] * BondGeometry::volumeCorrection(idist, mHorizon[j], mSpacing[i])) * mVolume[j];
+        }
+
+        /**
+         * @brief 键 i -> j 的体积修正因子: 邻居 j 计入损伤的有效体积为 refVolume * volumeFactor
+         *
+         * 取两端作用域修正因子的平均, 只在一端作用域内的键按一半计入.
+         */
+        double volumeFactor(int i, int j, double idist) const
+        {
+            return 0.5 * (BondGeometry::volumeCorrection(idist, mHorizon[i], mSpacing[j])
+                + BondGeometry::volumeCorrection(idist, mHorizon[j], mSpacing[i])) * mVolume[j] / mRefVolume;
+        }
+
+        /**
+         * @brief ADR 质量的放大系数: 对偶作用域的键刚度之和与只计本粒子作用域 (均匀模型) 之比, 不小于 1
+         *
+         * 粗粒子靠近细粒子时, 细粒子作用域的键常数较大, 按本粒子作用域估计的质量不足以保证稳定.
+         *
+         * @param idist 按键存储的参考键长 (Real 为键几何的存储类型)
+         * @param numParticles 计算粒子 [0, numParticles)
+         *
+         * @return NO_ERROR if success
+         */
+        template<typename Real>
+        int massScale(const BondTable& bonds, const Real* idist, int numParticles, std::vector<double>& scale) const;
+
+    private:
+        std::vector<double>     mSpacing;
+        std::vector<double>     mHorizon;
+        std::vector<double>     mBondConstant;
+        std::vector<double>     mVolume;
+        double                  mRefVolume;
+    };
+
+} // namespace caep
+
+#endif // __DUAL_HORIZON_H__
@@ -0,0 +1,68 @@
+#ifndef __HALF_BOND_KERNEL_H__
+#define __HALF_BOND_KERNEL_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "bond_table.h"
+#include "bond_kernel.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 半键模式 (牛顿第三定律): 每对粒子 i < j 只计算一次键力
+     *
+     * 键 i -> j 与 j -> i 的相对位置互为相反数, 拉伸率与键系数逐位相同, 因此键力只需计算一次.
+     * 计算分两步, 两步之间需要同步:
+     * 1. computePairs: 按所属粒子 (i < j 中的 i) 分段计算每对粒子的键力与拉伸率, 各段互不重叠;
+     * 2. gather: 每个粒子按自身键的顺序读取对应的键力并带符号累加, 同时判断断键 (有新断键时更新损伤).
+     * 两步均只写入本段的数据, 多线程下无需着色或私有缓冲; 累加顺序与逐键计算相同, 结果逐位一致.
+     * 键 i -> j 与 j -> i 的有效状态仍各自独立 (断裂区域限制只作用于一端).
+     * 粒子对按键编号索引, 不支持键表压缩 (BondTable::compact), 始终遍历全部键.
+     */
+    class HalfBondKernel {
+    public:
+        HalfBondKernel();
+
+        /**
+         * @brief 建立粒子对索引
+         *
+         * @param bonds 键表, 每个粒子的邻居须升序排列
+         * @param numActive 参与力计算的粒子为 [0, numActive), 其余粒子仅作为邻居出现
+         *
+         * @return NO_ERROR if success
+         */
+        int init(const BondTable& bonds, int numActive);
+
+        void clear();
+
+        size_t numPairs() const { return mPairBond.size(); }
+
+        /**
+         * @brief 计算粒子 [begin, end) 所属粒子对的键力, 不修改键有效状态
+         */
+        void computePairs(const BondKernelArgs& args, int begin, int end);
+
+        /**
+         * @brief 汇总粒子 [begin, end) 的键力与断键, 需在所有粒子对计算完成后调用
+         */
+        void gather(const BondKernelArgs& args, int begin, int end);
+
+        size_t sizeByByte() const;
+
+    private:
+        std::vector<size_t>     mPairOffsets;   // 粒子 i 所属的粒子对为 [mPairOffsets[i], mPairOffsets[i+1])
+        std::vector<size_t>     mPairBond;      // 粒子对对应的键 i -> j (i < j)
+        std::vector<int32_t>    mBondPair;      // 键对应的粒子对 p, 反向键 j -> i 存为 ~p
+
+        // 粒子对数据 (以 i -> j 方向计)
+        std::vector<double>     mForceX;
+        std::vector<double>     mForceY;
+        std::vector<double>     mStretch;
+        std::vector<uint8_t>    mValid;         // 变形后键长大于 0
+    };
+
+} // namespace caep
+
+#endif // __HALF_BOND_KERNEL_H__
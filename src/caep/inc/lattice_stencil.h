@@ -0,0 +1,129 @@
+#ifndef __LATTICE_STENCIL_H__
+#define __LATTICE_STENCIL_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "vec.h"
+#include "bond_table.h"
+#include "bond_kernel.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 模板核函数的输入 (由 LatticeStencil::kernelArgs 给出)
+     */
+    struct StencilKernelArgs {
+        int             size;       // 模板项数
+        const int64_t*  offsets;    // 格点偏移
+        const double*   rx;
+        const double*   ry;
+        const double*   idist;
+        const double*   invIdist;   // 1 / idist, 拉伸率以乘法计算
+
+        const int64_t*  cell;       // 粒子所在格点
+        const uint8_t*  regular;    // 规则粒子标记
+        const double*   gridx;      // 网格上的位移
+        const double*   gridy;
+    };
+
+    /**
+     * @brief 计算粒子 [begin, end) 的键力与断键, 非规则粒子调用 fallback
+     *
+     * 各指令集版本只是编译选项不同, 结果逐位一致.
+     */
+    using StencilKernelFunc = void (*)(const StencilKernelArgs& stencil, const BondKernelArgs& args,
+        BondKernelFunc fallback, int begin, int end);
+
+    void computeStencilScalar(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end);
+    void computeStencilAvx2(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end);
+    void computeStencilAvx512(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end);
+
+    /**
+     * @brief 规则方格点阵上的模板 (stencil) 键力计算, 不读取邻居列表与键几何数组
+     *
+     * 粒子位于间距为 dx 的方格点阵上, 作用域内的邻居偏移 (di, dj) 对所有粒子相同.
+     * 位移每步复制到带边框的二维网格, 邻居位移按固定偏移读取, 参考键长等几何量由模板给出,
+     * 每条键只读取键系数 coef 与有效位.
+     *
+     * 规则粒子: 模板内的格点均有粒子, 且邻居列表与模板按相同顺序一一对应 (键编号 offsets[i] + k 对应模板第 k 项).
+     * 粒子须按光栅顺序编号 (Morton 重排后没有规则粒子, 由 SimConfig::validate 拒绝).
+     * 其余粒子 (孔边、边界附近、不在点阵上) 以及键表压缩后有断键的粒子使用按键计算的核函数.
+     * 模板几何取精确的点阵偏移, 拉伸率乘以预先求得的 1 / idist (每条键少一次除法),
+     * 与逐键计算只有舍入差异.
+     */
+    class LatticeStencil {
+    public:
+        // 有效位一次读取, 模板项数不超过 32
+        static const int MAX_STENCIL = 32;
+
+        LatticeStencil();
+
+        /**
+         * @brief 建立点阵网格、模板与规则粒子标记
+         *
+         * @param coord 粒子坐标
+         * @param dx 点阵间距
+         * @param delta 作用域半径
+         * @param bonds 键表
+         * @param numActive 参与力计算的粒子为 [0, numActive)
+         *
+         * @return NO_ERROR if success
+         */
+        int init(const std::vector<Vec2>& coord, double dx, double delta, const BondTable& bonds, int numActive);
+
+        void clear();
+
+        int stencilSize() const { return static_cast<int>(mOffsets.size()); }
+        size_t numRegular() const { return mNumRegular; }
+
+        /**
+         * @brief 键表压缩后调用: 键顺序已改变的规则粒子改为逐键计算
+         *
+         * @return 改为逐键计算的粒子数
+         */
+        size_t refresh(const BondTable& bonds);
+
+        /**
+         * @brief 将粒子 [begin, end) 的位移复制到网格, 需在 compute 之前对所有粒子调用
+         */
+        void scatter(const double* dispx, const double* dispy, int begin, int end);
+
+        /**
+         * @brief 计算粒子 [begin, end) 的键力与断键, 非规则粒子调用 fallback
+         */
+        void compute(const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end) const;
+
+        StencilKernelArgs kernelArgs() const;
+
+        size_t sizeByByte() const;
+
+        /**
+         * @return 对应指令集的模板核函数, 不支持时返回标量版本
+         */
+        static StencilKernelFunc select(BondKernel::SimdLevel level);
+
+    private:
+        StencilKernelFunc       mKernel;
+
+        int                     mWidth;         // 网格每行格点数 (含边框)
+        std::vector<int64_t>    mCell;          // 粒子所在格点, 不在点阵上为 -1
+        std::vector<uint8_t>    mRegular;       // 规则粒子标记 (仅 [0, numActive))
+        size_t                  mNumRegular;
+
+        // 模板 (按 di、dj 升序)
+        std::vector<int64_t>    mOffsets;       // 格点偏移 di * width + dj
+        std::vector<double>     mRx;
+        std::vector<double>     mRy;
+        std::vector<double>     mIdist;
+        std::vector<double>     mInvIdist;
+
+        // 网格上的位移
+        std::vector<double>     mGridX;
+        std::vector<double>     mGridY;
+    };
+
+} // namespace caep
+
+#endif // __LATTICE_STENCIL_H__
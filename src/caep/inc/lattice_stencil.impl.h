@@ -0,0 +1,100 @@
+#ifndef __LATTICE_STENCIL_IMPL_H__
+#define __LATTICE_STENCIL_IMPL_H__
+
+#include <cmath>
+#include "lattice_stencil.h"
+
+// 模板核函数的实现, 由各指令集的源文件分别包含 (内部链接, 各自按本文件的编译选项生成代码)
+
+namespace caep {
+
+    // K 为编译期模板项数 (0 表示运行期确定), 固定项数时循环可完全展开并向量化
+    template<int K>
+    static inline void computeStencilRegular(const StencilKernelArgs& stencil, const BondKernelArgs& args, int i)
+    {
+        const int k = K > 0 ? K : stencil.size;
+        const size_t b0 = args.offsets[i];
+        const double* gx = stencil.gridx + stencil.cell[i];
+        const double* gy = stencil.gridy + stencil.cell[i];
+        const double* coef = args.coef + b0;
+
+        // 先逐项计算 (无跨项依赖, 可向量化), 再按模板顺序累加
+        double tx[LatticeStencil::MAX_STENCIL], ty[LatticeStencil::MAX_STENCIL], stretch[LatticeStencil::MAX_STENCIL];
+        for (int s = 0; s < k; ++s) {
+            double ux = stencil.rx[s] + (gx[stencil.offsets[s]] - gx[0]); // 变形后相对位置
+            double uy = stencil.ry[s] + (gy[stencil.offsets[s]] - gy[0]);
+            double nlength = std::sqrt(ux*ux + uy*uy);
+            stretch[s] = (nlength - stencil.idist[s]) * stencil.invIdist[s];
+            double t = coef[s] * stretch[s] / nlength; // 键长为 0 时结果无效, 由下面的选择丢弃
+            bool valid = nlength > 1e-10;
+            tx[s] = valid ? ux * t : 0.0;
+            ty[s] = valid ? uy * t : 0.0;
+        }
+
+        const uint32_t alive = loadAliveBits(args.alive, b0, k);
+        double fx = 0.0, fy = 0.0;
+        uint32_t over = 0;
+        for (int s = 0; s < k; ++s) {
+            bool a = (alive >> s) & 1;
+            fx += a ? tx[s] : 0.0;
+            fy += a ? ty[s] : 0.0;
+            over |= (std::abs(stretch[s]) > args.scr0 ? 1u : 0u) << s;
+        }
+
+        // 判断是否断裂（临界拉伸+区域限制）
+        uint32_t broken = args.breakable[i] ? (over & alive) : 0;
+        if (broken != 0) {
+            breakBonds(args, i, b0, broken);
+        }
+
+        args.forcex[i] = fx;
+        args.forcey[i] = fy;
+    }
+
+    // 同一行上连续 STENCIL_LANES 个规则粒子可按粒子方向向量化 (各粒子的邻居位移在网格上连续)
+    static const int STENCIL_LANES = 8;
+
+    using StencilBlockFunc = void (*)(const StencilKernelArgs& stencil, const BondKernelArgs& args, int i);
+
+    // 粒子 [i, i + STENCIL_LANES) 均为规则粒子且位于同一行的连续格点
+    static inline bool isStencilBlock(const StencilKernelArgs& stencil, int i, int end)
+    {
+        if (i + STENCIL_LANES > end) {
+            return false;
+        }
+        for (int l = 0; l < STENCIL_LANES; ++l) {
+            if (!stencil.regular[i + l] || stencil.cell[i + l] != stencil.cell[i] + l) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param block 整块 (STENCIL_LANES 个粒子) 的计算函数, 为空时逐个粒子计算
+     */
+    static inline void computeStencil(const StencilKernelArgs& stencil, const BondKernelArgs& args,
+        BondKernelFunc fallback, int begin, int end, StencilBlockFunc block = nullptr)
+    {
+        const bool fixed28 = stencil.size == 28; // delta = 3.015 dx
+        for (int i = begin; i < end; ) {
+            if (block != nullptr && isStencilBlock(stencil, i, end)) {
+                block(stencil, args, i);
+                i += STENCIL_LANES;
+                continue;
+            }
+
+            if (!stencil.regular[i]) {
+                fallback(args, i, i + 1);
+            } else if (fixed28) {
+                computeStencilRegular<28>(stencil, args, i);
+            } else {
+                computeStencilRegular<0>(stencil, args, i);
+            }
+            ++i;
+        }
+    }
+
+} // namespace caep
+
+#endif // __LATTICE_STENCIL_IMPL_H__
@@ -0,0 +1,62 @@
+#ifndef __NEIGHBOR_SEARCH_H__
+#define __NEIGHBOR_SEARCH_H__
+
+#include <vector>
+#include "vec.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 邻域搜索: 为每个粒子建立作用域 (delta) 内的邻居列表 (CSR 格式)
+     *
+     * 输出数组与 demo_hole 中的 numfam / pointfam / nodefam 含义一致:
+     * 粒子 i 的邻居为 nodefam[pointfam[i]] ... nodefam[pointfam[i] + numfam[i] - 1], 按粒子编号升序排列.
+     * 坐标类型 Point 为 Vec2 或 Vec3.
+     */
+    class NeighborSearch {
+    public:
+        /**
+         * @brief 均匀网格 (cell list) 搜索, 网格尺寸等于 delta, 复杂度 O(N)
+         *
+         * 每个粒子遍历相邻的 3^Dim 个网格.
+         *
+         * @param coord 粒子坐标
+         * @param delta 作用域半径
+         * @param numfam 每个粒子的邻居数量
+         * @param pointfam 每个粒子的邻居索引偏移
+         * @param nodefam 邻居列表 (大小与邻居总数一致)
+         *
+         * @return NO_ERROR if success
+         */
+        template<typename Point>
+        static int buildByCellList(const std::vector<Point>& coord, double delta,
+            std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam);
+
+        /**
+         * @brief 按粒子作用域半径搜索 (对偶作用域, 见 DualHorizon): j 为 i 的邻居当且仅当 |x_j - x_i| <= max(h_i, h_j)
+         *
+         * 网格尺寸取最小的作用域半径, 每个粒子先遍历覆盖自身作用域的网格得到有向作用域,
+         * 再与对偶作用域 (作用域包含该粒子的粒子) 合并, 邻居关系对称.
+         *
+         * @param horizons 各粒子的作用域半径
+         */
+        template<typename Point>
+        static int buildByCellList(const std::vector<Point>& coord, const std::vector<double>& horizons,
+            std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam);
+
+        /**
+         * @brief 两两比较搜索, 复杂度 O(N^2), 仅作为 cell list 结果的参考
+         */
+        template<typename Point>
+        static int buildByBruteForce(const std::vector<Point>& coord, double delta,
+            std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam);
+
+        template<typename Point>
+        static int buildByBruteForce(const std::vector<Point>& coord, const std::vector<double>& horizons,
+            std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam);
+    };
+
+} // namespace caep
+
+#endif // __NEIGHBOR_SEARCH_H__
@@ -0,0 +1,57 @@
+#ifndef __PARTICLE_ORDER_H__
+#define __PARTICLE_ORDER_H__
+
+#include <vector>
+#include <cstdint>
+#include "vec.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 粒子重编号: 按空间填充曲线 (Morton / Z 序) 排列粒子, 使空间相邻的粒子在内存中也相邻
+     *
+     * 重编号以区间为单位进行, 区间之间的相对顺序不变 (内部粒子、下边界、上边界仍各自连续).
+     * 排列用 order 表示: 新编号 k 的粒子为原编号 order[k] 的粒子.
+     */
+    class ParticleOrder {
+    public:
+        /**
+         * @brief 交错 x, y 的低 32 位得到 64 位 Morton 码
+         */
+        static uint64_t mortonCode(uint32_t x, uint32_t y);
+
+        /**
+         * @brief 将 [begin, end) 内的粒子按 Morton 码排序, 码相同时保持原顺序
+         *
+         * @param coord 粒子坐标
+         * @param begin 区间起点
+         * @param end 区间终点
+         * @param order 排列, 大小须为 coord.size(), 只修改 [begin, end) 部分
+         *
+         * @return NO_ERROR if success
+         */
+        static int sortByMorton(const std::vector<Vec2>& coord, size_t begin, size_t end, std::vector<int>& order);
+
+        /**
+         * @brief 逆排列: rank[order[k]] = k, 即原编号 i 的粒子的新编号为 rank[i]
+         */
+        static void inverse(const std::vector<int>& order, std::vector<int>& rank);
+
+        /**
+         * @brief 按排列重排数组: out[k] = in[order[k]]
+         */
+        template<class T>
+        static void apply(const std::vector<int>& order, std::vector<T>& data)
+        {
+            std::vector<T> permuted(data.size());
+            for (size_t k = 0; k < order.size(); ++k) {
+                permuted[k] = data[order[k]];
+            }
+            data.swap(permuted);
+        }
+    };
+
+} // namespace caep
+
+#endif // __PARTICLE_ORDER_H__
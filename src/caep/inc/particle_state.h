@@ -0,0 +1,123 @@
+#ifndef __PARTICLE_STATE_H__
+#define __PARTICLE_STATE_H__
+
+#include <cstddef>
+#include "vec.h"
+#include "xbuffer.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 二维矢量场的 SoA 视图: x, y 分量分别连续存储
+     */
+    struct VecField2 {
+        double* x;
+        double* y;
+
+        Vec2 operator[](size_t i) const { return {x[i], y[i]}; }
+        void set(size_t i, const Vec2& v) { x[i] = v.x; y[i] = v.y; }
+        double* component(int d) const { return d == 0 ? x : y; }
+    };
+
+    /**
+     * @brief 三维矢量场的 SoA 视图
+     */
+    struct VecField3 {
+        double* x;
+        double* y;
+        double* z;
+
+        Vec3 operator[](size_t i) const { return {x[i], y[i], z[i]}; }
+        void set(size_t i, const Vec3& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+        double* component(int d) const { return d == 0 ? x : (d == 1 ? y : z); }
+    };
+
+    // 维数 Dim 对应的矢量场视图, 分量 d 的起始地址为 base + d * stride
+    template<int Dim>
+    struct VecFieldOf;
+
+    template<>
+    struct VecFieldOf<2> {
+        typedef VecField2 type;
+        static VecField2 make(double* base, size_t stride) { return {base, base + stride}; }
+    };
+
+    template<>
+    struct VecFieldOf<3> {
+        typedef VecField3 type;
+        static VecField3 make(double* base, size_t stride) { return {base, base + stride, base + 2 * stride}; }
+    };
+
+    /**
+     * @brief 粒子状态容器 (structure of arrays), Dim 为空间维数
+     *
+     * 所有分量数组起始地址按 64 字节对齐, 长度填充到 SIMD 宽度 (8 个 double) 的整数倍,
+     * 填充部分初始为 0, 力计算、ADR 与输出阶段均可按连续 double 数组访问.
+     */
+    template<int Dim>
+    class BasicParticleState {
+    public:
+        typedef typename VecFieldOf<Dim>::type VecField;
+
+        static constexpr size_t ALIGNMENT = 64;
+        static constexpr size_t PADDING = ALIGNMENT / sizeof(double);
+
+        enum Field {
+            COORD = 0,      // 粒子坐标
+            DISP,           // 位移
+            VEL,            // 速度
+            FORCE,          // 总作用力
+            FORCE_OLD,      // 前一时间步力
+            VEL_HALF_OLD,   // 前半步速度
+            MASS,           // 质量向量（ADR用）
+            NUM_FIELDS
+        };
+
+        BasicParticleState();
+
+        /**
+         * @param n 粒子数
+         *
+         * @return NO_ERROR if success
+         */
+        int init(size_t n);
+
+        size_t size() const { return mSize; }
+        size_t capacity() const { return mCapacity; }
+
+        VecField field(Field f) const
+        {
+            return VecFieldOf<Dim>::make(mData.get() + Dim * static_cast<size_t>(f) * mCapacity, mCapacity);
+        }
+
+        VecField coord() const { return field(COORD); }
+        VecField disp() const { return field(DISP); }
+        VecField vel() const { return field(VEL); }
+        VecField force() const { return field(FORCE); }
+        VecField forceOld() const { return field(FORCE_OLD); }
+        VecField velHalfOld() const { return field(VEL_HALF_OLD); }
+        VecField mass() const { return field(MASS); }
+
+        // 损伤参数 (标量场)
+        double* damage() const { return mData.get() + Dim * NUM_FIELDS * mCapacity; }
+
+        /**
+         * @brief 将矢量场置零 (包括填充部分)
+         */
+        void zero(Field f);
+
+        size_t sizeByByte() const { return mData.sizeByByte(); }
+
+    private:
+        size_t                  mSize;
+        size_t                  mCapacity;
+        memory::XBuffer<double> mData;
+    };
+
+    using ParticleState = BasicParticleState<2>;
+    using ParticleState3 = BasicParticleState<3>;
+
+} // namespace caep
+
+#endif // __PARTICLE_STATE_H__
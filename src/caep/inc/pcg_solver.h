@@ -0,0 +1,85 @@
+#ifndef __PCG_SOLVER_H__
+#define __PCG_SOLVER_H__
+
+#include <vector>
+#include <cstddef>
+#include "bond_kernel.h"
+#include "xthread_reduce.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 键力在参考构型处线性化后的刚度算子 (不组装矩阵, 按键表逐键计算)
+     *
+     * 小变形下键力 f_i = sum_j c_ij (e_ij . (u_j - u_i)) e_ij, 其中 e_ij 为参考键方向, c_ij = coef / idist.
+     * 算子 (A p)_i = sum_j c_ij (e_ij . (p_i - p_j)) e_ij 只统计有效键, 在内部粒子上对称正定
+     * (边界粒子为位移边界, 对应分量取 0).
+     */
+    template<typename Real>
+    class BondJacobian {
+    public:
+        /**
+         * @brief 计算粒子 [begin, end) 的 q = A p
+         */
+        static void apply(const BasicBondKernelArgs<Real>& args, const double* px, const double* py,
+            double* qx, double* qy, int begin, int end);
+
+        /**
+         * @brief 粒子 [begin, end) 的对角元 (Jacobi 预条件), 没有有效键的粒子取 1
+         */
+        static void diagonal(const BasicBondKernelArgs<Real>& args, double* dx, double* dy, int begin, int end);
+    };
+
+    /**
+     * @brief Jacobi 预条件共轭梯度法求解 A x = b (A 见 BondJacobian)
+     *
+     * 内积按固定分块求和 (framework::DeterministicReduce), 结果与线程数无关.
+     */
+    template<typename Real>
+    class PcgSolver {
+    public:
+        struct Stats {
+            int     iterations;
+            double  residual;   // ||b - A x|| / ||b||
+        };
+
+        PcgSolver();
+
+        /**
+         * @param n 未知粒子数 (内部粒子 [0, n))
+         * @param numTotal 粒子总数 (邻居编号的上界)
+         *
+         * @return NO_ERROR if success
+         */
+        int init(int n, int numTotal);
+
+        /**
+         * @brief 从 x = 0 开始迭代至 ||r|| <= tolerance * ||b|| 或达到 maxIterations
+         *
+         * @param args 键表与键几何 (只读取 offsets, ends, neighbors, alive, rx, ry, idist, coef)
+         * @param bx, by 右端项
+         * @param xx, xy 输出的解 (大小至少为 n)
+         *
+         * @return NO_ERROR if success
+         */
+        int solve(const BasicBondKernelArgs<Real>& args, const double* bx, const double* by,
+            double* xx, double* xy, double tolerance, int maxIterations, Stats& stats);
+
+        size_t sizeByByte() const;
+
+    private:
+        int                                 mN;
+        size_t                              mTile;
+        std::vector<double>                 mRx, mRy;   // 残差
+        std::vector<double>                 mZx, mZy;   // 预条件残差
+        std::vector<double>                 mPx, mPy;   // 搜索方向 (长度为粒子总数, 边界分量为 0)
+        std::vector<double>                 mQx, mQy;   // A p
+        std::vector<double>                 mDx, mDy;   // 对角元
+        framework::DeterministicReduce<1>   mReduce1;
+        framework::DeterministicReduce<2>   mReduce2;
+    };
+
+} // namespace caep
+
+#endif // __PCG_SOLVER_H__
@@ -0,0 +1,186 @@
+#ifndef __PD_SOLVER_H__
+#define __PD_SOLVER_H__
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "caep.h"
+#include "sim_config.h"
+#include "vec.h"
+#include "dimension.h"
+#include "bond_table.h"
+#include "bond_geometry.h"
+#include "bond_kernel.h"
+#include "half_bond_kernel.h"
+#include "lattice_stencil.h"
+#include "damage_tracker.h"
+#include "particle_state.h"
+#include "domain_decomposition.h"
+#include "dual_horizon.h"
+#include "xshm_transport.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 带孔板单轴拉伸的近场动力学求解器 (动态松弛、准静态 PCG 或显式动力学)
+     *
+     * 问题规模、材料与时间参数均来自 SimConfig, 所有缓冲区在 init() 中按实际粒子数与键数分配.
+     * 精度策略 P 决定键几何的存储类型与键力核函数 (见 precision.h).
+     *
+     * Dim 为空间维数 (见 dimension.h). Dim = 3 时板沿 z 方向有 config.ndivz 层粒子, 中心孔贯穿厚度,
+     * 底部与顶部边界层覆盖整个厚度; 三维键族约 120 条键, 键几何另存 rz, 键力由三维核函数逐键计算.
+     *
+     * config.refineLevels > 0 时粒子间距不均匀: 板划分为边长 dx * 2^refineLevels 的单元, 单元按到孔边的距离取间距
+     * dx (孔边) 到 dx * 2^refineLevels (远处), 边界层取相邻单元的间距. 各粒子的作用域半径与间距成比例,
+     * 键刚度、表面修正与损伤按对偶作用域计算 (见 DualHorizon). 临界伸长率仍为全局常数, 断裂能随作用域半径增大,
+     * 裂纹在粗粒子区扩展较慢, 裂纹路径应落在加密区内 (加大 refineWidth); 加密区不随裂尖移动.
+     *
+     * 传输层 Transport (见 xshm_transport.h) 连接多个 rank 时按 DomainDecomposition 划分粒子: 每个 rank 只为拥有的粒子建键,
+     * 每步更新位移后与相邻 rank 交换幽灵层的位移, 松弛的全局和按 rank 顺序求和; 输出与 result 由 rank 0 汇总 (按全局粒子顺序).
+     * 三维、区域分解与变分辨率只支持 fp64 逐键计算的 ADR 松弛, 其余组合由 SimConfig::validate 拒绝.
+     */
+    template<typename P, int Dim = 2, typename Transport = ipc::LocalTransport>
+    class PdSolver {
+    public:
+        typedef typename P::Real Real;
+        typedef typename VecOf<Dim>::type Point;
+        typedef typename VecFieldOf<Dim>::type VecField;
+
+        /**
+         * @param transport 连接各 rank 的传输层 (已初始化), 为空时不划分区域
+         */
+        explicit PdSolver(Transport* transport = nullptr);
+
+        /**
+         * @brief 生成粒子、建立键表与键几何、计算表面修正因子并选择键力核函数
+         *
+         * @return NO_ERROR if success
+         */
+        int init(const SimConfig& config);
+
+        /**
+         * @brief 按 config.method 求解, 在 config.outputSteps 指定的时间步输出结果
+         *
+         * 二维输出 coord_disp_pd_<step>.txt, 三维输出 coord_disp_pd3d_<step>.txt (坐标、位移、损伤各列).
+         * 松弛求解 (SOLVER_RELAXATION, 积分器由 config.integrator 选择, 见 relaxation_integrator.h) 最多运行 config.steps 步;
+         * 设置了收敛容差时, 加载步收敛后进入下一个加载步, 最后一个加载步收敛后提前结束并输出当前时间步的结果.
+         * breakSubsteps > 0 时, 有新断键的粒子在本步内以新的键族重算键力, 并只对这些粒子局部松弛至多 breakSubsteps 次,
+         * 由此引起的连锁断键在同一加载状态内完成 (显式动力学只重算键力).
+         * 准静态求解 (SOLVER_PCG) 逐加载步以修正牛顿迭代求平衡, 每次迭代以 PCG 求解线性化刚度方程,
+         * 加载步 k 的结果按相同边界位移对应的时间步 steps * k / loadSteps 输出, 牛顿迭代总数不超过 config.steps.
+         * 显式动力学 (SOLVER_DYNAMIC) 以速度 Verlet 积分 config.steps 步, 步长为 safetyFactor 乘以临界步长
+         * (见 stable_time_step.h), subcycleLevels > 0 时按粒子的临界步长分层子循环.
+         *
+         * @param result 非空时输出最终的位移与损伤 (内部粒子, 按原粒子顺序, 只在 rank 0 上输出)
+         *
+         * @return NO_ERROR if success
+         */
+        int run(HoleResult* result = nullptr);
+
+        // 本 rank 拥有的内部粒子数与粒子总数 (不含幽灵粒子)
+        int numActive() const { return mTotInt; }
+        int numTotal() const { return mTotTop; }
+        int numGhosts() const { return mDomain.numGhosts(); }
+        size_t numBonds() const { return mBonds.numBonds(); }
+
+        // 本 rank 的粒子坐标 (分段同上, 单个 rank 且未重排时内部粒子与 result 的顺序相同)
+        const std::vector<Point>& points() const { return mPoints; }
+
+        // 本 rank 的键表与键几何 (键的有效状态随 run() 更新)
+        const BondTable& bonds() const { return mBonds; }
+        const BasicBondGeometry<Real>& geometry() const { return mGeometry; }
+
+    private:
+        void generateParticles();
+        void generateGradedParticles();
+        int reorderParticles();
+        int localizeParticles();
+        int buildBonds();
+        int computeSurfaceCorrection(std::vector<std::vector<double>>& fncst);
+        int buildKernels();
+        void printTraffic() const;
+        bool isRoot() const { return mTransport->rank() == 0; }
+        int exchangeGhosts(double* const* fields);      // Dim 个按粒子存储的字段, 幽灵粒子的值由所有者发来
+        int gatherInterior(std::vector<double>& table); // rank 0 上得到全局内部粒子的坐标、位移与损伤 (每行 2 * Dim + 1 列)
+        bool isOutputStep(int step) const;
+        int writeOutput(int step);                      // 各 rank 都须调用 (汇总后由 rank 0 写出)
+
+        // 加载步 increment 的边界位移对应的时间
+        double loadTime(int increment, int numIncrements) const;
+        void applyBoundary(size_t i, double ctime);
+        void compactBonds(int step);
+
+        template<typename Integrator>
+        int runRelaxation(Integrator& integrator, int& iterations);
+        int runQuasiStatic(int& iterations);
+
+        // particles 及其邻居中的内部粒子 (升序)
+        void expandRegion(const std::vector<int>& particles, std::vector<int>& region) const;
+
+        // 键数据存放在内存映射文件中时，提示内核预读粒子 [begin, end) 的键（通常为下一块）
+        void prefetchBonds(int begin, int end) const;
+
+        // 按区间重算键力与断键
+        void recomputeForces(const std::vector<std::pair<int, int>>& runs);
+
+        // 新断键立即生效并局部松弛, 返回子步数, numParticles 为参与局部松弛的粒子数
+        template<typename Integrator>
+        int settleBreaks(Integrator& integrator, size_t& numParticles);
+        int runDynamic(int& iterations);
+
+    private:
+        SimConfig                   mConfig;
+
+        // 区域分解
+        Transport                   mLocalTransport;    // 未指定传输层时使用 (单个 rank)
+        Transport*                  mTransport;
+        DomainDecomposition         mDomain;
+        int                         mGlobalInt;         // 全局内部粒子数
+        int                         mHaloChannel;       // 幽灵层交换
+        int                         mGatherChannel;     // 向 rank 0 汇总内部粒子
+        std::vector<std::vector<double>> mSendBuffers;
+        std::vector<std::vector<double>> mRecvBuffers;
+
+        // 由配置导出的物理参数
+        double                      mDx;        // 粒子间距 (变分辨率时为最细的间距)
+        double                      mDelta;     // 作用域半径 (同上)
+        double                      mThick;     // 板厚度 (二维)
+        double                      mVol;       // 单个粒子体积 (变分辨率时为最细的粒子体积, 即 fac 的体积基准)
+        double                      mBc;        // 键常数
+
+        // 本 rank 的粒子: 内部 [0, mTotInt), 底部边界 [mTotInt, mTotBottom), 顶部边界 [mTotBottom, mTotTop),
+        // 幽灵粒子 [mTotTop, mTotLocal)
+        int                         mTotInt;
+        int                         mTotBottom;
+        int                         mTotTop;
+        int                         mTotLocal;
+        std::vector<Point>          mPoints;    // 参考构型坐标 (用于邻域搜索与键几何)
+        std::vector<double>         mSpacing;   // 各粒子的间距, 均匀粒子时为空
+        DualHorizon                 mDual;
+        std::vector<int>            mRank;      // 原编号 -> 新编号 (按原顺序输出结果)
+        std::vector<uint8_t>        mBreakable; // 断裂判断区域限制
+        BasicParticleState<Dim>     mState;
+
+        // 键
+        BondTable                   mBonds;
+        BasicBondGeometry<Real>     mGeometry;
+        DamageTracker               mDamage;
+
+        // 键力计算
+        BondKernel::SimdLevel       mSimd;
+        PrecisionKernelFunc<P>      mKernel;
+        HalfBondKernel              mHalfBondKernel;
+        LatticeStencil              mStencil;
+        BasicBondKernelArgs<Real>   mKernelArgs;
+
+        // 断键压缩
+        bool                        mCompactEnabled;
+        size_t                      mLiveBonds;         // 参与计算的键数 (内部粒子)
+        size_t                      mBrokenAtCompaction;
+        size_t                      mNumCompactions;
+    };
+
+} // namespace caep
+
+#endif // __PD_SOLVER_H__
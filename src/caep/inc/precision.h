@@ -0,0 +1,36 @@
+#ifndef __PRECISION_H__
+#define __PRECISION_H__
+
+
+namespace caep {
+
+    /**
+     * @brief 精度策略 (编译期模板参数)
+     *
+     * Real 为键几何与键常数 (rx, ry, idist, fac, coef) 的存储类型, Accum 为键力计算与按粒子累加的类型.
+     * 位移、力、速度等粒子状态以及 ADR 求和始终为 double; 相对位移先以 double 相减再转换为 Accum,
+     * 避免大位移下的相消误差.
+     */
+    struct PrecisionFp64 {
+        typedef double Real;
+        typedef double Accum;
+        static const char* name() { return "fp64"; }
+    };
+
+    // 键几何按 float 存储 (键循环读取的数据量减半), 计算与累加仍为 double
+    struct PrecisionMixed {
+        typedef float Real;
+        typedef double Accum;
+        static const char* name() { return "mixed"; }
+    };
+
+    // 键几何与键力计算均为 float, SIMD 每次处理的键数加倍
+    struct PrecisionFp32 {
+        typedef float Real;
+        typedef float Accum;
+        static const char* name() { return "fp32"; }
+    };
+
+} // namespace caep
+
+#endif // __PRECISION_H__
@@ -0,0 +1,121 @@
+#ifndef __RELAXATION_INTEGRATOR_H__
+#define __RELAXATION_INTEGRATOR_H__
+
+#include <cstddef>
+#include "particle_state.h"
+#include "xthread_reduce.h"
+
+
+namespace caep {
+
+    /**
+     * 松弛积分器 (PdSolver::runRelaxation 的模板参数), 每个伪时间步分两遍扫描内部粒子:
+     * - 第一遍: 求解器计算键力后调用 accumulate(), 累加积分器需要的 NUM_SUMS 个部分和;
+     * - 两遍之间: prepare() 由全局和更新积分参数 (ADR 的阻尼系数, FIRE 的步长与混合系数);
+     * - 第二遍: update() 更新粒子 [begin, end) 的速度与位移.
+     * 积分器只读写 BasicParticleState<Dim> 中的字段 (各分量相同的公式), velHalfOld 保存上一步位移更新所用的速度
+     * (位移增量为 velHalfOld * timeStep()).
+     */
+
+    /**
+     * @brief 自适应动态松弛 (ADR): 阻尼系数 cn 由刚度的 Rayleigh 商估计, 步长固定
+     */
+    template<int Dim>
+    class BasicAdrIntegrator {
+    public:
+        static const int NUM_SUMS = 1;  // cn 的分子
+
+        BasicAdrIntegrator();
+
+        static const char* name() { return "adr"; }
+
+        void init(const BasicParticleState<Dim>& state, double dt);
+
+        void accumulate(size_t begin, size_t end, framework::CompensatedSum* partial) const;
+
+        /**
+         * @param step 伪时间步 (从 1 开始)
+         * @param sums accumulate() 的全局和
+         * @param dispNorm2 ||u||^2
+         * @param forceNorm2 ||f||^2
+         */
+        void prepare(int step, const double* sums, double dispNorm2, double forceNorm2);
+
+        void update(size_t begin, size_t end);
+
+        // 上一次 update() 使用的步长
+        double timeStep() const { return mDt; }
+
+    private:
+        // 各字段的 Dim 个分量
+        double*     mDisp[Dim];
+        double*     mVel[Dim];
+        double*     mForce[Dim];
+        double*     mForceOld[Dim];
+        double*     mVelHalfOld[Dim];
+        double*     mMass[Dim];
+        double      mDt;
+        double      mCn;        // 阻尼系数
+        bool        mFirst;     // 初始时间步
+    };
+
+    /**
+     * @brief FIRE (Fast Inertial Relaxation Engine, Bitzek et al. 2006)
+     *
+     * 功率 P = f . v > 0 时将速度向力的方向混合 v = (1 - alpha) v + alpha |v| f / |f|,
+     * 连续 minPositive 步 P > 0 后增大步长 (不超过 maxDt) 并减小 alpha;
+     * P <= 0 时速度清零、步长减半、alpha 复位. 之后按半隐式 Euler 推进 v += dt f / m, u += dt v.
+     */
+    template<int Dim>
+    class BasicFireIntegrator {
+    public:
+        static const int NUM_SUMS = 2;  // f . v, ||v||^2
+
+        struct Params {
+            double  startDtRatio;   // 初始步长 / config.dt
+            double  maxDtRatio;     // 最大步长 / config.dt
+            int     minPositive;
+            double  dtGrow;
+            double  dtShrink;
+            double  alphaStart;
+            double  alphaShrink;
+        };
+
+        static Params defaultParams() { return {0.5, 1.0, 5, 1.1, 0.5, 0.1, 0.99}; }
+
+        explicit BasicFireIntegrator(const Params& params = defaultParams());
+
+        static const char* name() { return "fire"; }
+
+        void init(const BasicParticleState<Dim>& state, double dt);
+
+        void accumulate(size_t begin, size_t end, framework::CompensatedSum* partial) const;
+
+        void prepare(int step, const double* sums, double dispNorm2, double forceNorm2);
+
+        void update(size_t begin, size_t end);
+
+        double timeStep() const { return mDt; }
+
+    private:
+        Params      mParams;
+        double*     mDisp[Dim];
+        double*     mVel[Dim];
+        double*     mForce[Dim];
+        double*     mForceOld[Dim];
+        double*     mVelHalfOld[Dim];
+        double*     mMass[Dim];
+        double      mDt0;
+        double      mDt;
+        double      mAlpha;
+        int         mNumPositive;   // 连续 P > 0 的步数
+        double      mKeep;          // 速度保留系数 (P <= 0 时为 0)
+        double      mMix;           // 力方向的混合系数 alpha |v| / |f|
+    };
+
+    using AdrIntegrator = BasicAdrIntegrator<2>;
+    using FireIntegrator = BasicFireIntegrator<2>;
+
+} // namespace caep
+
+#endif // __RELAXATION_INTEGRATOR_H__
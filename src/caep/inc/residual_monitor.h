@@ -0,0 +1,64 @@
+#ifndef __RESIDUAL_MONITOR_H__
+#define __RESIDUAL_MONITOR_H__
+
+#include <cstddef>
+#include "caep.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 准静态求解的残差监测与收敛判断
+     *
+     * 每次迭代记录两个相对残差:
+     * - 不平衡力: ||f|| / 本加载步内 ||f|| 的峰值 (位移边界加载没有外力, 以施加加载增量引起的不平衡力为参考);
+     * - 位移增量: ||u(n) - u(n-1)|| / ||u(n)||.
+     * 两个残差均低于容差 (容差为 0 的一项不判断)、本加载步至少迭代两次且最近 stableSteps 次迭代没有新断键时视为收敛.
+     */
+    class ResidualMonitor {
+    public:
+        ResidualMonitor();
+
+        void init(const ConvergencePolicy& policy);
+
+        // 至少设置了一个容差
+        bool enabled() const { return mPolicy.forceTolerance > 0.0 || mPolicy.dispTolerance > 0.0; }
+
+        /**
+         * @brief 开始新的加载步, 清除不平衡力峰值
+         */
+        void beginIncrement();
+
+        /**
+         * @brief 记录一次迭代 (均为内部粒子上的平方和)
+         *
+         * @param iteration 全局迭代序号
+         * @param forceNorm2 ||f||^2
+         * @param dispIncrementNorm2 ||u(n) - u(n-1)||^2
+         * @param dispNorm2 ||u(n)||^2
+         * @param numBroken 累计断键数
+         */
+        void update(int iteration, double forceNorm2, double dispIncrementNorm2, double dispNorm2, size_t numBroken);
+
+        bool converged() const;
+
+        double forceResidual() const { return mForceResidual; }
+        double dispResidual() const { return mDispResidual; }
+
+        // 本加载步已迭代次数
+        int incrementIterations() const { return mIncrementIterations; }
+
+    private:
+        ConvergencePolicy   mPolicy;
+        double              mPeakForceNorm2;
+        double              mForceResidual;
+        double              mDispResidual;
+        int                 mIncrementIterations;
+        int                 mIteration;
+        int                 mLastBreak;     // 最近一次出现新断键的迭代序号
+        size_t              mNumBroken;
+    };
+
+} // namespace caep
+
+#endif // __RESIDUAL_MONITOR_H__
@@ -0,0 +1,108 @@
+#ifndef __SIM_CONFIG_H__
+#define __SIM_CONFIG_H__
+
+#include <string>
+#include <vector>
+#include "caep.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 带孔方板算例的运行期配置, 默认值与原 demo_hole 相同
+     *
+     * 可由 JSON 文件加载, 文件按分组组织 (各分组与各项均可省略):
+     * {
+     *     "problem":  {"dimension": 2, "ndivx": 100, "ndivy": 100, "ndivz": 10, "nband": 3, "length": 0.05, "width": 0.05,
+     *                  "holeRadius": 0.005, "horizon": 3.015, "refineLevels": 0, "refineWidth": 0.0025},
+     *     "material": {"density": 8000.0, "youngModulus": 192.0e9, "criticalStretch": 0.02},
+     *     "loading":  {"velocity": 2.7541e-7},
+     *     "time":     {"steps": 1000, "dt": 1.0, "outputSteps": [675, 750, 825, 1000],
+     *                  "safetyFactor": 0.8, "subcycleLevels": 0},
+     *     "convergence": {"loadSteps": 0, "forceTolerance": 0.0, "dispTolerance": 0.0, "stableSteps": 10,
+     *                     "cgTolerance": 1e-8, "cgMaxIterations": 2000},
+     *     "solver":   {"method": "relaxation", "integrator": "adr", "threads": 1, "engine": "bond", "precision": "fp64", "reorder": false,
+     *                  "compactEvery": 0, "compactThreshold": 0.0,
+     *                  "breakSubsteps": 0, "bondStorage": "", "ranks": 1}
+     * }
+     * 每一项也可按名称单独设置 (命令行 --hole-radius 0.01 对应 holeRadius).
+     */
+    struct SimConfig {
+        // 几何与离散
+        int                 dimension;      // 空间维数, 3 为沿 z 方向 ndivz 层的厚板 (孔贯穿厚度)
+        int                 ndivx;          // x方向网格数
+        int                 ndivy;          // y方向网格数
+        int                 ndivz;          // z方向网格数 (三维)
+        int                 nband;          // 边界层数
+        double              length;         // 板长度
+        double              width;          // 板宽度
+        double              holeRadius;     // 中心孔半径
+        double              horizon;        // 作用域半径 / 粒子间距
+        int                 refineLevels;   // 变分辨率: 粒子间距由孔边的 dx 逐层加倍到 dx * 2^refineLevels (对偶作用域), 0 为均匀粒子
+        double              refineWidth;    // 最细一层到孔边的距离, 第 k 层延伸到 refineWidth * (2^(k+1) - 1)
+
+        // 材料
+        double              density;        // 密度
+        double              youngModulus;   // 弹性模量
+        double              criticalStretch;// 临界拉伸阈值
+
+        // 加载: 底部与顶部边界粒子的速度
+        double              velocity;
+
+        // 时间积分
+        int                 steps;          // 总时间步
+        double              dt;             // 时间步长
+        std::vector<int>    outputSteps;    // 输出结果的时间步
+        double              safetyFactor;   // 显式动力学步长 / 临界步长 (SOLVER_DYNAMIC, dt 不使用)
+        int                 subcycleLevels; // 子循环最大层级, 0 为不子循环 (半键模式不支持)
+        ConvergencePolicy   convergence;    // 加载步与收敛判断 (见 ResidualMonitor)
+        double              cgTolerance;    // PCG 相对残差容差 (SOLVER_PCG)
+        int                 cgMaxIterations;// PCG 单次求解的最大迭代次数
+
+        // 求解
+        SolverMethod        method;
+        Integrator          integrator;     // 松弛积分器 (SOLVER_RELAXATION)
+        size_t              threads;
+        ForceEngine         engine;
+        Precision           precision;
+        bool                reorder;        // Morton 序重编号 (点阵模板不支持)
+        CompactionPolicy    compaction;
+        int                 breakSubsteps;  // 断键后局部松弛的最大子步数, 0 为断键下一步生效 (半键模式不支持)
+        std::string         bondStorage;    // 键表与键几何的内存映射文件目录, 为空时存放在内存中
+        int                 ranks;          // 区域分解的进程数 (本机进程, 共享内存交换幽灵层), 1 为不划分
+
+        SimConfig();
+
+        /**
+         * @brief 从 JSON 文件加载, 文件中未出现的项保持原值
+         *
+         * @return NO_ERROR if success
+         */
+        int load(const std::string& filename);
+
+        /**
+         * @brief 按名称设置一项 (名称同 JSON 中的键, 也可写作 hole-radius 形式)
+         *
+         * @param value 数值、true/false、求解方法、积分器、计算方式、精度名称或目录; outputSteps 以逗号分隔
+         *
+         * @return NO_ERROR if success, ERROR_NOT_SUPPORTED if name is unknown
+         */
+        int set(const std::string& name, const std::string& value);
+
+        /**
+         * @return NO_ERROR if all values are in range
+         */
+        int validate() const;
+
+        double dx() const { return length / ndivx; }
+
+        // 内部粒子 (不含孔) 与边界粒子总数的上界
+        size_t maxParticles() const
+        {
+            return static_cast<size_t>(ndivx) * (ndivy + 2 * nband) * (dimension == 3 ? ndivz : 1);
+        }
+    };
+
+} // namespace caep
+
+#endif // __SIM_CONFIG_H__
@@ -0,0 +1,37 @@
+#ifndef __STABLE_TIME_STEP_H__
+#define __STABLE_TIME_STEP_H__
+
+#include <cstddef>
+#include <cstdint>
+#include "bond_kernel.h"
+
+
+namespace caep {
+
+    /**
+     * @brief 显式动力学的稳定步长 (Silling & Askari 2005)
+     *
+     * 粒子 i 的临界步长 dt_i = sqrt(2 rho / sum_j C_ij V_j), 其中 C_ij V_j = coef / idist (只统计有效键).
+     * 子循环时粒子 i 的层级 L_i = floor(log2(dt_i / min dt)), 每 2^L 步以 2^L 倍步长更新一次.
+     */
+    class StableTimeStep {
+    public:
+        /**
+         * @brief 计算粒子 [begin, end) 的临界步长, 没有有效键的粒子取无穷大
+         */
+        template<typename Real>
+        static void compute(const BasicBondKernelArgs<Real>& args, double density, double* dt, int begin, int end);
+
+        /**
+         * @brief 粒子 [begin, end) 的子循环层级
+         *
+         * @param dt 临界步长
+         * @param minDt 全部粒子临界步长的最小值
+         * @param maxLevel 最大层级, 为 0 时不子循环
+         */
+        static void levels(const double* dt, double minDt, int maxLevel, uint8_t* level, int begin, int end);
+    };
+
+} // namespace caep
+
+#endif // __STABLE_TIME_STEP_H__
@@ -0,0 +1,53 @@
+#ifndef __STEP_TRAFFIC_H__
+#define __STEP_TRAFFIC_H__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace caep {
+
+    /**
+     * @brief 每个时间步的内存流量估计: 按各遍扫描读写的数组大小解析计算
+     *
+     * 每遍扫描读写的数组各计一次 (同一遍内重复访问视为缓存命中), 邻居位移的收集访问不计入.
+     */
+    class StepTraffic {
+    public:
+        struct Pass {
+            std::string name;
+            size_t      bytes;
+        };
+
+        /**
+         * @brief 记录一遍扫描
+         *
+         * @param name 名称
+         * @param count 扫描的元素 (粒子或键) 数量
+         * @param bytesPerItem 每个元素读写的字节数
+         */
+        void addPass(const std::string& name, size_t count, double bytesPerItem);
+
+        /**
+         * @brief 向最后一遍扫描追加流量 (融合到同一遍的计算)
+         */
+        void addToPass(size_t count, double bytesPerItem);
+
+        size_t numPasses() const { return mPasses.size(); }
+        const std::vector<Pass>& passes() const { return mPasses; }
+
+        size_t bytes() const;
+
+        double bytesPerBond(size_t numBonds) const
+        {
+            return numBonds > 0 ? double(bytes()) / numBonds : 0.0;
+        }
+
+    private:
+        std::vector<Pass> mPasses;
+    };
+
+} // namespace caep
+
+#endif // __STEP_TRAFFIC_H__
@@ -0,0 +1,49 @@
+#ifndef __SURFACE_CORRECTION_H__
+#define __SURFACE_CORRECTION_H__
+
+#include <vector>
+#include <cstddef>
+#include "bond_table.h"
+
+
+namespace caep {
+
+    class DualHorizon;
+
+    /**
+     * @brief 表面修正因子 (能量法)
+     *
+     * 对每个方向 d 施加均匀拉伸 u = strain * x_d e_d, 粒子 i 的近场动力学应变能密度为
+     * W_i^d = sum_j 1/4 bc s_ij^2 idist vol fac, 修正因子为连续介质应变能密度与其之比 sedload / W_i^d.
+     * 全部方向在同一遍键表扫描中计算 (键长与体积修正每条键只算一次), 各粒子只读取参考坐标, 按粒子分块并行.
+     * 没有键 (W = 0) 的孤立粒子不修正, 因子取 1.
+     * 粒子间距不均匀时 (Params::dual 非空) 键权重 bc vol fac 换为对偶作用域的键刚度 (见 DualHorizon).
+     */
+    class SurfaceCorrection {
+    public:
+        struct Params {
+            double  delta;      // 作用域半径
+            double  dx;         // 粒子间距
+            double  bc;         // 键常数
+            double  vol;        // 粒子体积
+            double  strain;     // 施加的拉伸应变
+            double  sedload;    // 连续介质在该拉伸下的应变能密度
+            const DualHorizon* dual;    // 按粒子的间距与作用域, 为空时各粒子相同
+        };
+
+        /**
+         * @param bonds 键表
+         * @param coords 各方向的坐标分量 (二维为 x, y), 方向数为 coords.size()
+         * @param numParticles 计算粒子 [0, numParticles)
+         * @param tile 按粒子分块的大小 (须已初始化线程池), 为 0 时串行计算
+         * @param factors 输出, factors[d][i] 为粒子 i 在方向 d 的修正因子
+         *
+         * @return NO_ERROR if success
+         */
+        static int compute(const BondTable& bonds, const std::vector<const double*>& coords, int numParticles,
+            const Params& params, size_t tile, std::vector<std::vector<double>>& factors);
+    };
+
+} // namespace caep
+
+#endif // __SURFACE_CORRECTION_H__
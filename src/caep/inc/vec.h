@@ -0,0 +1,56 @@
+#ifndef __VEC_H__
+#define __VEC_H__
+
+#include <cmath>
+
+
+namespace caep {
+
+    // 二维向量结构体（包含坐标和运算）
+    struct Vec2
+    {
+        double x, y;
+        Vec2(double x = 0, double y = 0) : x(x), y(y) {}
+        Vec2 operator+(const Vec2& other) const { return {x + other.x, y + other.y}; }
+        Vec2 operator-(const Vec2& other) const { return {x - other.x, y - other.y}; }
+        Vec2 operator*(double scalar) const { return {x * scalar, y * scalar}; }
+        double operator[](int d) const { return d == 0 ? x : y; }  // 第 d 个分量
+        double magnitude() const { return std::sqrt(x*x + y*y); }  // 向量模长
+    };
+
+    // 三维向量结构体
+    struct Vec3
+    {
+        double x, y, z;
+        Vec3(double x = 0, double y = 0, double z = 0) : x(x), y(y), z(z) {}
+        Vec3 operator+(const Vec3& other) const { return {x + other.x, y + other.y, z + other.z}; }
+        Vec3 operator-(const Vec3& other) const { return {x - other.x, y - other.y, z - other.z}; }
+        Vec3 operator*(double scalar) const { return {x * scalar, y * scalar, z * scalar}; }
+        double operator[](int d) const { return d == 0 ? x : (d == 1 ? y : z); }
+        double magnitude() const { return std::sqrt(x*x + y*y + z*z); }
+    };
+
+    // 计算两点间距离
+    inline double distance(const Vec2& a, const Vec2& b)
+    {
+        return (a - b).magnitude();
+    }
+
+    inline double distance(const Vec3& a, const Vec3& b)
+    {
+        return (a - b).magnitude();
+    }
+
+    // 维数 Dim 对应的向量类型
+    template<int Dim>
+    struct VecOf;
+
+    template<>
+    struct VecOf<2> { typedef Vec2 type; };
+
+    template<>
+    struct VecOf<3> { typedef Vec3 type; };
+
+} // namespace caep
+
+#endif // __VEC_H__
@@ -0,0 +1,134 @@
+#include <vector>
+#include <cmath>
+#include <numeric>
+
+#define TAG_LOGGER "[CAEP]"
+#include "logger.h"
+
+#include "caep.h"
+#include "timer.h"
+#include "neighbor_search.h"
+#include "bond_table.h"
+#include "bond_geometry.h"
+#include "bond_kernel.h"
+#include "damage_tracker.h"
+#include "particle_order.h"
+
+using namespace std;
+using namespace caep;
+
+
+// 单位方板 (中心孔半径 0.1), 粒子按光栅顺序生成
+static vector<Vec2> makePlate(int ndiv)
+{
+    vector<Vec2> points;
+    double dx = 1.0 / ndiv;
+    for (int i = 0; i < ndiv; ++i) {
+        for (int j = 0; j < ndiv; ++j) {
+            double x = -0.5 + (j + 0.5) * dx;
+            double y = -0.5 + (i + 0.5) * dx;
+            if (sqrt(x*x + y*y) > 0.1) {
+                points.push_back({x, y});
+            }
+        }
+    }
+    return points;
+}
+
+// 返回键循环的耗时 (ns/键)
+static int timeBondLoop(const vector<Vec2>& points, double dx, BondKernelFunc kernel, double& nsPerBond)
+{
+    const int n = static_cast<int>(points.size());
+    const double delta = 3.015 * dx;
+
+    BondTable bonds;
+    {
+        vector<int> numfam, pointfam, nodefam;
+        int ret = NeighborSearch::buildByCellList(points, delta, numfam, pointfam, nodefam);
+        ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+        ret = bonds.init(numfam, std::move(nodefam));
+        ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+    }
+
+    BondGeometry geometry;
+    vector<double> fncst(n, 1.0);
+    int ret = geometry.build(bonds, points, fncst, fncst, {delta, dx, 1.0, dx * dx * dx, nullptr});
+    ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+
+    vector<double> dispx(n), dispy(n), fx(n), fy(n), dmg(n);
+    vector<uint8_t> breakable(n, 0);
+    for (int i = 0; i < n; ++i) {
+        dispx[i] = 1e-3 * points[i].x;
+        dispy[i] = -3e-4 * points[i].y;
+    }
+
+    DamageTracker damage;
+    ret = damage.init(bonds, geometry.fac(), dx * dx * dx, n, dmg.data());
+    ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+
+    BondKernelArgs args;
+    args.offsets = bonds.offsets();
+    args.ends = bonds.liveEnds();
+    args.neighbors = bonds.neighbors();
+    args.alive = bonds.aliveMask();
+    args.rx = geometry.rx();
+    args.ry = geometry.ry();
+    args.idist = geometry.idist();
+    args.fac = geometry.fac();
+    args.coef = geometry.coef();
+    args.dispx = dispx.data();
+    args.dispy = dispy.data();
+    args.breakable = breakable.data();
+    args.scr0 = 0.02;
+    args.vol = dx * dx * dx;
+    args.forcex = fx.data();
+    args.forcey = fy.data();
+    args.brokenWeight = damage.brokenWeight();
+    args.refWeight = damage.refWeight();
+    args.damage = dmg.data();
+    args.numBroken = damage.brokenCounter();
+
+    // 预热一次, 之后重复至约 2e8 次键计算
+    kernel(args, 0, n);
+    size_t repeats = max<size_t>(3, size_t(2e8) / max<size_t>(bonds.numBonds(), 1));
+
+    perf::Timer timer;
+    for (size_t r = 0; r < repeats; ++r) {
+        kernel(args, 0, n);
+    }
+    nsPerBond = timer.count() * 1e6 / (double(repeats) * bonds.numBonds());
+
+    return NO_ERROR;
+}
+
+int bench_reorder(size_t maxParticles)
+{
+    ASSERTER_WITH_RET(maxParticles >= 100000, ERROR_INVALID_PARAMETER);
+
+    BondKernel::SimdLevel simd = BondKernel::detect();
+    BondKernelFunc kernel = BondKernel::select(simd);
+
+    LOGGER_I("bond loop throughput, raster vs morton order (%s kernel)\n", BondKernel::name(simd));
+    LOGGER_I("%12s %14s %14s %10s\n", "particles", "raster(ns/b)", "morton(ns/b)", "speedup");
+    for (size_t target = 100000; target <= maxParticles; target *= 10) {
+        int ndiv = static_cast<int>(sqrt(double(target)));
+        vector<Vec2> points = makePlate(ndiv);
+
+        double raster = 0.0, morton = 0.0;
+        int ret = timeBondLoop(points, 1.0 / ndiv, kernel, raster);
+        ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+
+        vector<int> order(points.size());
+        iota(order.begin(), order.end(), 0);
+        ret = ParticleOrder::sortByMorton(points, 0, points.size(), order);
+        ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+        ParticleOrder::apply(order, points);
+
+        ret = timeBondLoop(points, 1.0 / ndiv, kernel, morton);
+        ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+
+        LOGGER_I("%12zu %14.3f %14.3f %10.2f\n", points.size(), raster, morton, raster / morton);
+    }
+
+    return NO_ERROR;
+}
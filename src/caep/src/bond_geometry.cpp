@@ -0,0 +1,167 @@
+#include <cmath>
+#include "bond_geometry.h"
+#include "dual_horizon.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    template<typename Real>
+    BasicBondGeometry<Real>::BasicBondGeometry()
+    {
+        ;
+    }
+
+    template<typename Real>
+    double BasicBondGeometry<Real>::volumeCorrection(double idist, double delta, double dx)
+    {
+        if (idist <= delta - dx/2) {
+            return 1.0;
+        } else if (idist <= delta + dx/2) {
+            return (delta + dx/2 - idist) / dx;
+        }
+        return 0.0;
+    }
+
+    template<typename Real>
+    int BasicBondGeometry<Real>::build(const BondTable& bonds, const std::vector<Vec2>& coord,
+        const std::vector<double>& fncstX, const std::vector<double>& fncstY, const Params& params)
+    {
+        const int n = static_cast<int>(bonds.numParticles());
+        ASSERTER_WITH_RET(coord.size() == static_cast<size_t>(n), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(fncstX.size() == static_cast<size_t>(n), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(fncstY.size() == static_cast<size_t>(n), ERROR_INVALID_PARAMETER);
+
+        const size_t nbonds = bonds.numBonds();
+        mRx.resize(nbonds);
+        mRy.resize(nbonds);
+        mIdist.resize(nbonds);
+        mFac.resize(nbonds);
+        mCoef.resize(nbonds);
+
+        for (int i = 0; i < n; ++i) {
+            for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                int cnode = bonds.neighbor(b);
+                Vec2 r_ij = coord[cnode] - coord[i];
+                double idist = r_ij.magnitude();
+                double fac = params.dual != nullptr ? params.dual->volumeFactor(i, cnode, idist)
+                    : volumeCorrection(idist, params.delta, params.dx);
+
+                // 角度计算（用于各向异性修正）
+                double theta = 0.0;
+                if (idist > 1e-10) {
+                    theta = std::atan2(std::abs(r_ij.y), std::abs(r_ij.x)); // 0到π/2之间的角度
+                }
+
+                // 表面修正因子（考虑不同方向的材料特性差异）
+                double scx = (fncstX[i] + fncstX[cnode]) / 2.0;
+                double scy = (fncstY[i] + fncstY[cnode]) / 2.0;
+                double scr = 1.0 / std::sqrt(std::pow(std::cos(theta)/scx, 2) + std::pow(std::sin(theta)/scy, 2));
+
+                mRx[b] = static_cast<Real>(r_ij.x);
+                mRy[b] = static_cast<Real>(r_ij.y);
+                mIdist[b] = static_cast<Real>(idist);
+                mFac[b] = static_cast<Real>(fac);
+                mCoef[b] = static_cast<Real>(params.dual != nullptr ? params.dual->stiffness(i, cnode, idist) * scr
+                    : params.bc * params.vol * scr * fac);
+            }
+        }
+
+        return NO_ERROR;
+    }
+
+    template<typename Real>
+    int BasicBondGeometry<Real>::build(const BondTable& bonds, const std::vector<Vec3>& coord,
+        const std::vector<std::vector<double>>& fncst, const Params& params)
+    {
+        const int n = static_cast<int>(bonds.numParticles());
+        ASSERTER_WITH_RET(coord.size() == static_cast<size_t>(n), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(fncst.size() == 3, ERROR_INVALID_PARAMETER);
+        for (const std::vector<double>& factors : fncst) {
+            ASSERTER_WITH_RET(factors.size() == static_cast<size_t>(n), ERROR_INVALID_PARAMETER);
+        }
+
+        const size_t nbonds = bonds.numBonds();
+        mRx.resize(nbonds);
+        mRy.resize(nbonds);
+        mRz.resize(nbonds);
+        mIdist.resize(nbonds);
+        mFac.resize(nbonds);
+        mCoef.resize(nbonds);
+
+        for (int i = 0; i < n; ++i) {
+            for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                int cnode = bonds.neighbor(b);
+                Vec3 r_ij = coord[cnode] - coord[i];
+                double idist = r_ij.magnitude();
+                double fac = params.dual != nullptr ? params.dual->volumeFactor(i, cnode, idist)
+                    : volumeCorrection(idist, params.delta, params.dx);
+
+                // 按键方向插值两端粒子的表面修正因子 (二维时与 theta 形式相同)
+                double scr = 1.0;
+                if (idist > 1e-10) {
+                    double sum = 0.0;
+                    for (int d = 0; d < 3; ++d) {
+                        double sc = (fncst[d][i] + fncst[d][cnode]) / 2.0;
+                        double nd = r_ij[d] / idist / sc;
+                        sum += nd * nd;
+                    }
+                    scr = 1.0 / std::sqrt(sum);
+                }
+
+                mRx[b] = static_cast<Real>(r_ij.x);
+                mRy[b] = static_cast<Real>(r_ij.y);
+                mRz[b] = static_cast<Real>(r_ij.z);
+                mIdist[b] = static_cast<Real>(idist);
+                mFac[b] = static_cast<Real>(fac);
+                mCoef[b] = static_cast<Real>(params.dual != nullptr ? params.dual->stiffness(i, cnode, idist) * scr
+                    : params.bc * params.vol * scr * fac);
+            }
+        }
+
+        return NO_ERROR;
+    }
+
+    template<typename Real>
+    void BasicBondGeometry<Real>::setStorage(const std::string& directory)
+    {
+        memory::XMapAllocator<Real> allocator(directory);
+        for (BondArray<Real>* field : {&mRx, &mRy, &mRz, &mIdist, &mFac, &mCoef}) {
+            *field = BondArray<Real>(allocator);
+        }
+    }
+
+    template<typename Real>
+    void BasicBondGeometry<Real>::prefetch(size_t begin, size_t end) const
+    {
+        if (!mIdist.get_allocator().isMapped() || begin >= end) {
+            return;
+        }
+        for (const BondArray<Real>* field : {&mRx, &mRy, &mRz, &mIdist, &mFac, &mCoef}) {
+            if (!field->empty()) {
+                memory::adviseWillNeed(field->data() + begin, (end - begin) * sizeof(Real));
+            }
+        }
+    }
+
+    template<typename Real>
+    void BasicBondGeometry<Real>::clear()
+    {
+        mRx.clear();
+        mRy.clear();
+        mRz.clear();
+        mIdist.clear();
+        mFac.clear();
+        mCoef.clear();
+    }
+
+    template<typename Real>
+    size_t BasicBondGeometry<Real>::sizeByByte() const
+    {
+        return (mRx.size() + mRy.size() + mRz.size() + mIdist.size() + mFac.size() + mCoef.size()) * sizeof(Real);
+    }
+
+    template class BasicBondGeometry<float>;
+    template class BasicBondGeometry<double>;
+
+} // namespace caep
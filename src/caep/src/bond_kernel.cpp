@@ -0,0 +1,157 @@
+#include "bond_kernel.impl.h"
+
+
+namespace caep {
+
+    void computeBondForcesScalar(const BondKernelArgs& args, int begin, int end)
+    {
+        computeBondForces<double>(args, begin, end);
+    }
+
+    void computeBondForces3Scalar(const BondKernelArgs& args, int begin, int end)
+    {
+        computeBondForces3<double>(args, begin, end);
+    }
+
+    void computeBondForcesMixedScalar(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        computeBondForces<double>(args, begin, end);
+    }
+
+    void computeBondForcesFp32Scalar(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        computeBondForces<float>(args, begin, end);
+    }
+
+#if !defined(CAEP_HAVE_AVX2)
+    void computeBondForcesAvx2(const BondKernelArgs& args, int begin, int end)
+    {
+        computeBondForcesScalar(args, begin, end);
+    }
+
+    void computeBondForcesMixedAvx2(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        computeBondForcesMixedScalar(args, begin, end);
+    }
+
+    void computeBondForcesFp32Avx2(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        computeBondForcesFp32Scalar(args, begin, end);
+    }
+#endif
+
+#if !defined(CAEP_HAVE_AVX512)
+    void computeBondForcesAvx512(const BondKernelArgs& args, int begin, int end)
+    {
+        computeBondForcesScalar(args, begin, end);
+    }
+
+    void computeBondForcesMixedAvx512(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        computeBondForcesMixedScalar(args, begin, end);
+    }
+
+    void computeBondForcesFp32Avx512(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        computeBondForcesFp32Scalar(args, begin, end);
+    }
+#endif
+
+    bool BondKernel::isSupported(SimdLevel level)
+    {
+        switch (level) {
+            case SCALAR:
+                return true;
+#if defined(CAEP_HAVE_AVX2)
+            case AVX2:
+                return __builtin_cpu_supports("avx2");
+#endif
+#if defined(CAEP_HAVE_AVX512)
+            case AVX512:
+                return __builtin_cpu_supports("avx512f");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    BondKernel::SimdLevel BondKernel::detect()
+    {
+        if (isSupported(AVX512)) {
+            return AVX512;
+        }
+        if (isSupported(AVX2)) {
+            return AVX2;
+        }
+        return SCALAR;
+    }
+
+    BondKernelFunc BondKernel::select(SimdLevel level)
+    {
+        if (!isSupported(level)) {
+            return computeBondForcesScalar;
+        }
+
+        switch (level) {
+            case AVX2:
+                return computeBondForcesAvx2;
+            case AVX512:
+                return computeBondForcesAvx512;
+            default:
+                return computeBondForcesScalar;
+        }
+    }
+
+    template<>
+    PrecisionKernelFunc<PrecisionFp64> BondKernel::select<PrecisionFp64>(SimdLevel level)
+    {
+        return select(level);
+    }
+
+    template<>
+    PrecisionKernelFunc<PrecisionMixed> BondKernel::select<PrecisionMixed>(SimdLevel level)
+    {
+        if (!isSupported(level)) {
+            return computeBondForcesMixedScalar;
+        }
+
+        switch (level) {
+            case AVX2:
+                return computeBondForcesMixedAvx2;
+            case AVX512:
+                return computeBondForcesMixedAvx512;
+            default:
+                return computeBondForcesMixedScalar;
+        }
+    }
+
+    template<>
+    PrecisionKernelFunc<PrecisionFp32> BondKernel::select<PrecisionFp32>(SimdLevel level)
+    {
+        if (!isSupported(level)) {
+            return computeBondForcesFp32Scalar;
+        }
+
+        switch (level) {
+            case AVX2:
+                return computeBondForcesFp32Avx2;
+            case AVX512:
+                return computeBondForcesFp32Avx512;
+            default:
+                return computeBondForcesFp32Scalar;
+        }
+    }
+
+    const char* BondKernel::name(SimdLevel level)
+    {
+        switch (level) {
+            case AVX2:
+                return "avx2";
+            case AVX512:
+                return "avx512";
+            default:
+                return "scalar";
+        }
+    }
+
+} // namespace caep
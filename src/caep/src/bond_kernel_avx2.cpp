@@ -0,0 +1,222 @@
+#if defined(CAEP_HAVE_AVX2)
+
+#include <immintrin.h>
+#include "bond_kernel.impl.h"
+
+
+namespace caep {
+
+    static inline double horizontalSum(__m256d v)
+    {
+        __m128d lo = _mm256_castpd256_pd128(v);
+        __m128d hi = _mm256_extractf128_pd(v, 1);
+        lo = _mm_add_pd(lo, hi);
+        return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+    }
+
+    static inline float horizontalSum(__m256 v)
+    {
+        __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+        return _mm_cvtss_f32(_mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1)));
+    }
+
+    // 将 4 位有效位展开为 4 个 64 位通道掩码
+    static inline __m256d expandMask(uint32_t bits)
+    {
+        const __m256i select = _mm256_set_epi64x(8, 4, 2, 1);
+        __m256i v = _mm256_and_si256(_mm256_set1_epi64x(bits), select);
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(v, select));
+    }
+
+    // 将 8 位有效位展开为 8 个 32 位通道掩码
+    static inline __m256 expandMask8(uint32_t bits)
+    {
+        const __m256i select = _mm256_set_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+        __m256i v = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), select);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(v, select));
+    }
+
+    // 读取 4 个 float 并转换为 double
+    static inline __m256d loadFloat4(const float* p)
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(p));
+    }
+
+    void computeBondForcesAvx2(const BondKernelArgs& args, int begin, int end)
+    {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d eps = _mm256_set1_pd(1e-10);
+        const __m256d scr0 = _mm256_set1_pd(args.scr0);
+        const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+
+        for (int i = begin; i < end; ++i) {
+            const size_t b0 = args.offsets[i];
+            const size_t b1 = args.ends[i];
+            const bool breakable = args.breakable[i] != 0;
+
+            const __m256d dxi = _mm256_set1_pd(args.dispx[i]);
+            const __m256d dyi = _mm256_set1_pd(args.dispy[i]);
+            __m256d fx = zero, fy = zero;
+
+            size_t b = b0;
+            for (; b + 4 <= b1; b += 4) {
+                __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(args.neighbors + b));
+                __m256d djx = _mm256_i32gather_pd(args.dispx, idx, 8);
+                __m256d djy = _mm256_i32gather_pd(args.dispy, idx, 8);
+
+                __m256d ux = _mm256_add_pd(_mm256_loadu_pd(args.rx + b), _mm256_sub_pd(djx, dxi));
+                __m256d uy = _mm256_add_pd(_mm256_loadu_pd(args.ry + b), _mm256_sub_pd(djy, dyi));
+                __m256d nlength = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(ux, ux), _mm256_mul_pd(uy, uy)));
+                __m256d idist = _mm256_loadu_pd(args.idist + b);
+                __m256d stretch = _mm256_div_pd(_mm256_sub_pd(nlength, idist), idist);
+
+                uint32_t bits = loadAliveBits(args.alive, b, 4);
+                __m256d alive = expandMask(bits);
+                __m256d valid = _mm256_and_pd(alive, _mm256_cmp_pd(nlength, eps, _CMP_GT_OQ));
+
+                __m256d t = _mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(args.coef + b), stretch), nlength);
+                fx = _mm256_add_pd(fx, _mm256_and_pd(valid, _mm256_mul_pd(ux, t)));
+                fy = _mm256_add_pd(fy, _mm256_and_pd(valid, _mm256_mul_pd(uy, t)));
+
+                // 判断是否断裂（临界拉伸+区域限制）
+                if (breakable) {
+                    __m256d over = _mm256_cmp_pd(_mm256_and_pd(stretch, absMask), scr0, _CMP_GT_OQ);
+                    uint32_t broken = static_cast<uint32_t>(_mm256_movemask_pd(over)) & bits;
+                    if (broken != 0) {
+                        breakBonds(args, i, b, broken);
+                    }
+                }
+            }
+
+            double sfx = horizontalSum(fx), sfy = horizontalSum(fy);
+
+            // 剩余不足 4 条的键按标量处理
+            for (; b < b1; ++b) {
+                computeBond(args, i, b, breakable, sfx, sfy);
+            }
+
+            args.forcex[i] = sfx;
+            args.forcey[i] = sfy;
+        }
+    }
+
+    // 与 double 版本相同, 键几何以 float 读取后转换
+    void computeBondForcesMixedAvx2(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d eps = _mm256_set1_pd(1e-10);
+        const __m256d scr0 = _mm256_set1_pd(args.scr0);
+        const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+
+        for (int i = begin; i < end; ++i) {
+            const size_t b0 = args.offsets[i];
+            const size_t b1 = args.ends[i];
+            const bool breakable = args.breakable[i] != 0;
+
+            const __m256d dxi = _mm256_set1_pd(args.dispx[i]);
+            const __m256d dyi = _mm256_set1_pd(args.dispy[i]);
+            __m256d fx = zero, fy = zero;
+
+            size_t b = b0;
+            for (; b + 4 <= b1; b += 4) {
+                __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(args.neighbors + b));
+                __m256d djx = _mm256_i32gather_pd(args.dispx, idx, 8);
+                __m256d djy = _mm256_i32gather_pd(args.dispy, idx, 8);
+
+                __m256d ux = _mm256_add_pd(loadFloat4(args.rx + b), _mm256_sub_pd(djx, dxi));
+                __m256d uy = _mm256_add_pd(loadFloat4(args.ry + b), _mm256_sub_pd(djy, dyi));
+                __m256d nlength = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(ux, ux), _mm256_mul_pd(uy, uy)));
+                __m256d idist = loadFloat4(args.idist + b);
+                __m256d stretch = _mm256_div_pd(_mm256_sub_pd(nlength, idist), idist);
+
+                uint32_t bits = loadAliveBits(args.alive, b, 4);
+                __m256d valid = _mm256_and_pd(expandMask(bits), _mm256_cmp_pd(nlength, eps, _CMP_GT_OQ));
+
+                __m256d t = _mm256_div_pd(_mm256_mul_pd(loadFloat4(args.coef + b), stretch), nlength);
+                fx = _mm256_add_pd(fx, _mm256_and_pd(valid, _mm256_mul_pd(ux, t)));
+                fy = _mm256_add_pd(fy, _mm256_and_pd(valid, _mm256_mul_pd(uy, t)));
+
+                // 判断是否断裂（临界拉伸+区域限制）
+                if (breakable) {
+                    __m256d over = _mm256_cmp_pd(_mm256_and_pd(stretch, absMask), scr0, _CMP_GT_OQ);
+                    uint32_t broken = static_cast<uint32_t>(_mm256_movemask_pd(over)) & bits;
+                    if (broken != 0) {
+                        breakBonds(args, i, b, broken);
+                    }
+                }
+            }
+
+            double sfx = horizontalSum(fx), sfy = horizontalSum(fy);
+            for (; b < b1; ++b) {
+                computeBond(args, i, b, breakable, sfx, sfy);
+            }
+
+            args.forcex[i] = sfx;
+            args.forcey[i] = sfy;
+        }
+    }
+
+    // 每次处理 8 条键: 邻居位移按 double 收集并相减后转换为 float, 其余计算均为 float
+    void computeBondForcesFp32Avx2(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 eps = _mm256_set1_ps(1e-10f);
+        const __m256 scr0 = _mm256_set1_ps(static_cast<float>(args.scr0));
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+
+        for (int i = begin; i < end; ++i) {
+            const size_t b0 = args.offsets[i];
+            const size_t b1 = args.ends[i];
+            const bool breakable = args.breakable[i] != 0;
+
+            const __m256d dxi = _mm256_set1_pd(args.dispx[i]);
+            const __m256d dyi = _mm256_set1_pd(args.dispy[i]);
+            __m256 fx = zero, fy = zero;
+
+            size_t b = b0;
+            for (; b + 8 <= b1; b += 8) {
+                __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(args.neighbors + b));
+                __m128i idxLo = _mm256_castsi256_si128(idx);
+                __m128i idxHi = _mm256_extracti128_si256(idx, 1);
+                __m128 dxLo = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_i32gather_pd(args.dispx, idxLo, 8), dxi));
+                __m128 dxHi = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_i32gather_pd(args.dispx, idxHi, 8), dxi));
+                __m128 dyLo = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_i32gather_pd(args.dispy, idxLo, 8), dyi));
+                __m128 dyHi = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_i32gather_pd(args.dispy, idxHi, 8), dyi));
+
+                __m256 ux = _mm256_add_ps(_mm256_loadu_ps(args.rx + b), _mm256_insertf128_ps(_mm256_castps128_ps256(dxLo), dxHi, 1));
+                __m256 uy = _mm256_add_ps(_mm256_loadu_ps(args.ry + b), _mm256_insertf128_ps(_mm256_castps128_ps256(dyLo), dyHi, 1));
+                __m256 nlength = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(ux, ux), _mm256_mul_ps(uy, uy)));
+                __m256 idist = _mm256_loadu_ps(args.idist + b);
+                __m256 stretch = _mm256_div_ps(_mm256_sub_ps(nlength, idist), idist);
+
+                uint32_t bits = loadAliveBits(args.alive, b, 8);
+                __m256 valid = _mm256_and_ps(expandMask8(bits), _mm256_cmp_ps(nlength, eps, _CMP_GT_OQ));
+
+                __m256 t = _mm256_div_ps(_mm256_mul_ps(_mm256_loadu_ps(args.coef + b), stretch), nlength);
+                fx = _mm256_add_ps(fx, _mm256_and_ps(valid, _mm256_mul_ps(ux, t)));
+                fy = _mm256_add_ps(fy, _mm256_and_ps(valid, _mm256_mul_ps(uy, t)));
+
+                // 判断是否断裂（临界拉伸+区域限制）
+                if (breakable) {
+                    __m256 over = _mm256_cmp_ps(_mm256_and_ps(stretch, absMask), scr0, _CMP_GT_OQ);
+                    uint32_t broken = static_cast<uint32_t>(_mm256_movemask_ps(over)) & bits;
+                    if (broken != 0) {
+                        breakBonds(args, i, b, broken);
+                    }
+                }
+            }
+
+            float sfx = horizontalSum(fx), sfy = horizontalSum(fy);
+            for (; b < b1; ++b) {
+                computeBond(args, i, b, breakable, sfx, sfy);
+            }
+
+            args.forcex[i] = sfx;
+            args.forcey[i] = sfy;
+        }
+    }
+
+} // namespace caep
+
+#endif // CAEP_HAVE_AVX2
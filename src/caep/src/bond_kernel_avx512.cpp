@@ -0,0 +1,181 @@
+#if defined(CAEP_HAVE_AVX512)
+
+#include <immintrin.h>
+#include "bond_kernel.impl.h"
+
+
+namespace caep {
+
+    // 读取 lanes 指定的 float (其余通道取 fill) 并转换为 double
+    static inline __m512d loadFloat8(__mmask8 lanes, const float* p, float fill = 0.0f)
+    {
+        __m512 v = _mm512_mask_loadu_ps(_mm512_set1_ps(fill), static_cast<__mmask16>(lanes), p);
+        return _mm512_cvtps_pd(_mm512_castps512_ps256(v));
+    }
+
+    void computeBondForcesAvx512(const BondKernelArgs& args, int begin, int end)
+    {
+        const __m512d zero = _mm512_setzero_pd();
+        const __m512d eps = _mm512_set1_pd(1e-10);
+        const __m512d scr0 = _mm512_set1_pd(args.scr0);
+
+        for (int i = begin; i < end; ++i) {
+            const size_t b0 = args.offsets[i];
+            const size_t b1 = args.ends[i];
+            const bool breakable = args.breakable[i] != 0;
+
+            const __m512d dxi = _mm512_set1_pd(args.dispx[i]);
+            const __m512d dyi = _mm512_set1_pd(args.dispy[i]);
+            __m512d fx = zero, fy = zero;
+
+            // 每次处理 8 条键, 尾部以掩码处理不足 8 条的部分
+            for (size_t b = b0; b < b1; b += 8) {
+                const int n = static_cast<int>(b1 - b < 8 ? b1 - b : 8);
+                const __mmask8 lanes = static_cast<__mmask8>((1u << n) - 1);
+
+                __m256i idx = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32(static_cast<__mmask16>(lanes), args.neighbors + b));
+                __m512d djx = _mm512_mask_i32gather_pd(zero, lanes, idx, args.dispx, 8);
+                __m512d djy = _mm512_mask_i32gather_pd(zero, lanes, idx, args.dispy, 8);
+
+                __m512d ux = _mm512_add_pd(_mm512_maskz_loadu_pd(lanes, args.rx + b), _mm512_sub_pd(djx, dxi));
+                __m512d uy = _mm512_add_pd(_mm512_maskz_loadu_pd(lanes, args.ry + b), _mm512_sub_pd(djy, dyi));
+                __m512d nlength = _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(ux, ux), _mm512_mul_pd(uy, uy)));
+                // 无效通道的参考键长置 1, 避免除零
+                __m512d idist = _mm512_mask_loadu_pd(_mm512_set1_pd(1.0), lanes, args.idist + b);
+                __m512d stretch = _mm512_div_pd(_mm512_sub_pd(nlength, idist), idist);
+
+                __mmask8 alive = static_cast<__mmask8>(loadAliveBits(args.alive, b, n));
+                __mmask8 valid = _mm512_mask_cmp_pd_mask(alive, nlength, eps, _CMP_GT_OQ);
+
+                __m512d t = _mm512_maskz_div_pd(valid, _mm512_mul_pd(_mm512_maskz_loadu_pd(lanes, args.coef + b), stretch), nlength);
+                fx = _mm512_mask_add_pd(fx, valid, fx, _mm512_mul_pd(ux, t));
+                fy = _mm512_mask_add_pd(fy, valid, fy, _mm512_mul_pd(uy, t));
+
+                // 判断是否断裂（临界拉伸+区域限制）
+                if (breakable) {
+                    __mmask8 broken = _mm512_mask_cmp_pd_mask(alive, _mm512_abs_pd(stretch), scr0, _CMP_GT_OQ);
+                    if (broken != 0) {
+                        breakBonds(args, i, b, broken);
+                    }
+                }
+            }
+
+            args.forcex[i] = _mm512_reduce_add_pd(fx);
+            args.forcey[i] = _mm512_reduce_add_pd(fy);
+        }
+    }
+
+    // 与 double 版本相同, 键几何以 float 读取后转换
+    void computeBondForcesMixedAvx512(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        const __m512d zero = _mm512_setzero_pd();
+        const __m512d eps = _mm512_set1_pd(1e-10);
+        const __m512d scr0 = _mm512_set1_pd(args.scr0);
+
+        for (int i = begin; i < end; ++i) {
+            const size_t b0 = args.offsets[i];
+            const size_t b1 = args.ends[i];
+            const bool breakable = args.breakable[i] != 0;
+
+            const __m512d dxi = _mm512_set1_pd(args.dispx[i]);
+            const __m512d dyi = _mm512_set1_pd(args.dispy[i]);
+            __m512d fx = zero, fy = zero;
+
+            for (size_t b = b0; b < b1; b += 8) {
+                const int n = static_cast<int>(b1 - b < 8 ? b1 - b : 8);
+                const __mmask8 lanes = static_cast<__mmask8>((1u << n) - 1);
+
+                __m256i idx = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32(static_cast<__mmask16>(lanes), args.neighbors + b));
+                __m512d djx = _mm512_mask_i32gather_pd(zero, lanes, idx, args.dispx, 8);
+                __m512d djy = _mm512_mask_i32gather_pd(zero, lanes, idx, args.dispy, 8);
+
+                __m512d ux = _mm512_add_pd(loadFloat8(lanes, args.rx + b), _mm512_sub_pd(djx, dxi));
+                __m512d uy = _mm512_add_pd(loadFloat8(lanes, args.ry + b), _mm512_sub_pd(djy, dyi));
+                __m512d nlength = _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(ux, ux), _mm512_mul_pd(uy, uy)));
+                __m512d idist = loadFloat8(lanes, args.idist + b, 1.0f);
+                __m512d stretch = _mm512_div_pd(_mm512_sub_pd(nlength, idist), idist);
+
+                __mmask8 alive = static_cast<__mmask8>(loadAliveBits(args.alive, b, n));
+                __mmask8 valid = _mm512_mask_cmp_pd_mask(alive, nlength, eps, _CMP_GT_OQ);
+
+                __m512d t = _mm512_maskz_div_pd(valid, _mm512_mul_pd(loadFloat8(lanes, args.coef + b), stretch), nlength);
+                fx = _mm512_mask_add_pd(fx, valid, fx, _mm512_mul_pd(ux, t));
+                fy = _mm512_mask_add_pd(fy, valid, fy, _mm512_mul_pd(uy, t));
+
+                // 判断是否断裂（临界拉伸+区域限制）
+                if (breakable) {
+                    __mmask8 broken = _mm512_mask_cmp_pd_mask(alive, _mm512_abs_pd(stretch), scr0, _CMP_GT_OQ);
+                    if (broken != 0) {
+                        breakBonds(args, i, b, broken);
+                    }
+                }
+            }
+
+            args.forcex[i] = _mm512_reduce_add_pd(fx);
+            args.forcey[i] = _mm512_reduce_add_pd(fy);
+        }
+    }
+
+    // 收集 lanes 指定邻居的位移并减去 di, 转换为 16 个 float (前 8 个通道对应 idx 的低半部分)
+    static inline __m512 gatherRelative(__m512i idx, __mmask16 lanes, const double* disp, __m512d di)
+    {
+        const __m512d zero = _mm512_setzero_pd();
+        __m512d lo = _mm512_mask_i32gather_pd(zero, static_cast<__mmask8>(lanes), _mm512_castsi512_si256(idx), disp, 8);
+        __m512d hi = _mm512_mask_i32gather_pd(zero, static_cast<__mmask8>(lanes >> 8), _mm512_extracti64x4_epi64(idx, 1), disp, 8);
+        __m256 flo = _mm512_cvtpd_ps(_mm512_sub_pd(lo, di));
+        __m256 fhi = _mm512_cvtpd_ps(_mm512_sub_pd(hi, di));
+        return _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(flo)), _mm256_castps_pd(fhi), 1));
+    }
+
+    // 每次处理 16 条键, 邻居位移按 double 收集并相减后转换为 float, 其余计算均为 float
+    void computeBondForcesFp32Avx512(const BasicBondKernelArgs<float>& args, int begin, int end)
+    {
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 eps = _mm512_set1_ps(1e-10f);
+        const __m512 scr0 = _mm512_set1_ps(static_cast<float>(args.scr0));
+
+        for (int i = begin; i < end; ++i) {
+            const size_t b0 = args.offsets[i];
+            const size_t b1 = args.ends[i];
+            const bool breakable = args.breakable[i] != 0;
+
+            const __m512d dxi = _mm512_set1_pd(args.dispx[i]);
+            const __m512d dyi = _mm512_set1_pd(args.dispy[i]);
+            __m512 fx = zero, fy = zero;
+
+            for (size_t b = b0; b < b1; b += 16) {
+                const int n = static_cast<int>(b1 - b < 16 ? b1 - b : 16);
+                const __mmask16 lanes = static_cast<__mmask16>((1u << n) - 1);
+
+                __m512i idx = _mm512_maskz_loadu_epi32(lanes, args.neighbors + b);
+                __m512 ux = _mm512_add_ps(_mm512_maskz_loadu_ps(lanes, args.rx + b), gatherRelative(idx, lanes, args.dispx, dxi));
+                __m512 uy = _mm512_add_ps(_mm512_maskz_loadu_ps(lanes, args.ry + b), gatherRelative(idx, lanes, args.dispy, dyi));
+                __m512 nlength = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(ux, ux), _mm512_mul_ps(uy, uy)));
+                // 无效通道的参考键长置 1, 避免除零
+                __m512 idist = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), lanes, args.idist + b);
+                __m512 stretch = _mm512_div_ps(_mm512_sub_ps(nlength, idist), idist);
+
+                __mmask16 alive = static_cast<__mmask16>(loadAliveBits(args.alive, b, n));
+                __mmask16 valid = _mm512_mask_cmp_ps_mask(alive, nlength, eps, _CMP_GT_OQ);
+
+                __m512 t = _mm512_maskz_div_ps(valid, _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, args.coef + b), stretch), nlength);
+                fx = _mm512_mask_add_ps(fx, valid, fx, _mm512_mul_ps(ux, t));
+                fy = _mm512_mask_add_ps(fy, valid, fy, _mm512_mul_ps(uy, t));
+
+                // 判断是否断裂（临界拉伸+区域限制）
+                if (breakable) {
+                    __mmask16 broken = _mm512_mask_cmp_ps_mask(alive, _mm512_abs_ps(stretch), scr0, _CMP_GT_OQ);
+                    if (broken != 0) {
+                        breakBonds(args, i, b, broken);
+                    }
+                }
+            }
+
+            args.forcex[i] = _mm512_reduce_add_ps(fx);
+            args.forcey[i] = _mm512_reduce_add_ps(fy);
+        }
+    }
+
+} // namespace caep
+
+#endif // CAEP_HAVE_AVX512
@@ -0,0 +1,422 @@
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "neighbor_search.h"
+#include "bond_table.h"
+#include "bond_geometry.h"
+#include "bond_kernel.h"
+#include "half_bond_kernel.h"
+#include "damage_tracker.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    struct KernelFixture {
+        std::vector<caep::Vec2> points;
+        caep::BondTable bonds;
+        caep::BondGeometry geometry;
+        caep::BasicBondGeometry<float> geometryFloat;
+        std::vector<double> dispx, dispy;
+        std::vector<uint8_t> breakable;
+        double vol;
+        caep::DamageTracker damage;
+
+        // 规则方阵, 位移为均匀拉伸加随机扰动, 扰动较大的键会超过临界拉伸
+        explicit KernelFixture(int ndiv)
+        {
+            double dx = 1.0 / ndiv;
+            double delta = 3.015 * dx;
+            for (int i = 0; i < ndiv; ++i) {
+                for (int j = 0; j < ndiv; ++j) {
+                    points.push_back({(j + 0.5) * dx, (i + 0.5) * dx});
+                }
+            }
+
+            std::vector<int> numfam, pointfam, nodefam;
+            caep::NeighborSearch::buildByCellList(points, delta, numfam, pointfam, nodefam);
+            bonds.init(numfam, std::move(nodefam));
+
+            std::vector<double> fncst(points.size(), 1.0);
+            vol = dx * dx * dx;
+            geometry.build(bonds, points, fncst, fncst, {delta, dx, 1.0e11, vol, nullptr});
+            geometryFloat.build(bonds, points, fncst, fncst, {delta, dx, 1.0e11, vol, nullptr});
+
+            std::srand(7);
+            for (size_t i = 0; i < points.size(); ++i) {
+                double noise = (std::rand() % 16 == 0) ? 0.3 * dx : 1e-4 * dx;
+                dispx.push_back(1e-3 * points[i].x + noise * (std::rand() / (double)RAND_MAX - 0.5));
+                dispy.push_back(-3e-4 * points[i].y + noise * (std::rand() / (double)RAND_MAX - 0.5));
+                breakable.push_back(std::abs(points[i].y - 0.5) <= 0.25 ? 1 : 0);
+            }
+        }
+
+        caep::BondKernelArgs makeArgs(double scr0, std::vector<uint64_t>& alive,
+            std::vector<double>& fx, std::vector<double>& fy, std::vector<double>& dmg)
+        {
+            return makeArgs(geometry, scr0, alive, fx, fy, dmg);
+        }
+
+        template<typename Real>
+        caep::BasicBondKernelArgs<Real> makeArgs(const caep::BasicBondGeometry<Real>& geometry, double scr0,
+            std::vector<uint64_t>& alive, std::vector<double>& fx, std::vector<double>& fy, std::vector<double>& dmg)
+        {
+            int n = static_cast<int>(points.size());
+            alive.assign(bonds.aliveMask(), bonds.aliveMask() + (bonds.numBonds() + 63) / 64);
+            fx.assign(n, 0.0);
+            fy.assign(n, 0.0);
+            dmg.assign(n, 0.0);
+            damage.init(bonds, geometry.fac(), vol, n, dmg.data());
+
+            caep::BasicBondKernelArgs<Real> args;
+            args.offsets = bonds.offsets();
+            args.ends = bonds.liveEnds();
+            args.neighbors = bonds.neighbors();
+            args.alive = alive.data();
+            args.rx = geometry.rx();
+            args.ry = geometry.ry();
+            args.idist = geometry.idist();
+            args.fac = geometry.fac();
+            args.coef = geometry.coef();
+            args.dispx = dispx.data();
+            args.dispy = dispy.data();
+            args.breakable = breakable.data();
+            args.scr0 = scr0;
+            args.vol = vol;
+            args.forcex = fx.data();
+            args.forcey = fy.data();
+            args.brokenWeight = damage.brokenWeight();
+            args.refWeight = damage.refWeight();
+            args.damage = dmg.data();
+            args.numBroken = damage.brokenCounter();
+            return args;
+        }
+
+        void run(caep::BondKernelFunc kernel, double scr0, std::vector<uint64_t>& alive,
+            std::vector<double>& fx, std::vector<double>& fy, std::vector<double>& dmg, int n = -1)
+        {
+            run(geometry, kernel, scr0, alive, fx, fy, dmg, n);
+        }
+
+        template<typename Real>
+        void run(const caep::BasicBondGeometry<Real>& geometry, void (*kernel)(const caep::BasicBondKernelArgs<Real>&, int, int),
+            double scr0, std::vector<uint64_t>& alive, std::vector<double>& fx, std::vector<double>& fy,
+            std::vector<double>& dmg, int n = -1)
+        {
+            n = n < 0 ? static_cast<int>(points.size()) : n;
+            caep::BasicBondKernelArgs<Real> args = makeArgs(geometry, scr0, alive, fx, fy, dmg);
+
+            // 分两段调用, 覆盖区间边界
+            kernel(args, 0, n / 3);
+            kernel(args, n / 3, n);
+        }
+    };
+
+    void expectMatchesScalar(caep::BondKernel::SimdLevel level)
+    {
+        if (!caep::BondKernel::isSupported(level)) {
+            GTEST_SKIP() << caep::BondKernel::name(level) << " not supported on this cpu";
+        }
+
+        const double scr0 = 0.02;
+        KernelFixture fixture(48);
+
+        std::vector<uint64_t> aliveRef, alive;
+        std::vector<double> fxRef, fyRef, dmgRef, fx, fy, dmg;
+        fixture.run(caep::computeBondForcesScalar, scr0, aliveRef, fxRef, fyRef, dmgRef);
+        fixture.run(caep::BondKernel::select(level), scr0, alive, fx, fy, dmg);
+
+        // 断键判断与损伤与标量版本逐位一致, 力仅有求和顺序带来的舍入差异
+        ASSERT_EQ(alive, aliveRef);
+        EXPECT_EQ(dmg, dmgRef);
+
+        size_t broken = 0;
+        for (size_t b = 0; b < fixture.bonds.numBonds(); ++b) {
+            broken += ((aliveRef[b >> 6] >> (b & 63)) & 1) ? 0 : 1;
+        }
+        EXPECT_GT(broken, 0u);
+
+        double scale = 0.0;
+        for (size_t i = 0; i < fxRef.size(); ++i) {
+            scale = std::max(scale, std::max(std::abs(fxRef[i]), std::abs(fyRef[i])));
+        }
+        for (size_t i = 0; i < fxRef.size(); ++i) {
+            EXPECT_NEAR(fx[i], fxRef[i], 1e-12 * scale) << "particle " << i;
+            EXPECT_NEAR(fy[i], fyRef[i], 1e-12 * scale) << "particle " << i;
+        }
+    }
+
+    size_t countDiffer(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b)
+    {
+        size_t n = 0;
+        for (size_t w = 0; w < a.size(); ++w) {
+            n += __builtin_popcountll(a[w] ^ b[w]);
+        }
+        return n;
+    }
+
+    // 各指令集版本与同精度的标量版本断键一致, 与 fp64 只有键几何舍入带来的差异
+    template<typename P>
+    void expectPrecisionMatches(double simdTolerance, double fp64Tolerance)
+    {
+        const double scr0 = 0.02;
+        KernelFixture fixture(48);
+
+        std::vector<uint64_t> alive64, aliveRef;
+        std::vector<double> fx64, fy64, dmg64, fxRef, fyRef, dmgRef;
+        fixture.run(caep::computeBondForcesScalar, scr0, alive64, fx64, fy64, dmg64);
+        fixture.run(fixture.geometryFloat, caep::BondKernel::select<P>(caep::BondKernel::SCALAR), scr0, aliveRef, fxRef, fyRef, dmgRef);
+
+        double scale = 0.0;
+        size_t broken = 0;
+        for (size_t i = 0; i < fx64.size(); ++i) {
+            scale = std::max(scale, std::max(std::abs(fx64[i]), std::abs(fy64[i])));
+        }
+        for (size_t w = 0; w < alive64.size(); ++w) {
+            broken += 64 - __builtin_popcountll(alive64[w]);
+        }
+        EXPECT_LE(countDiffer(aliveRef, alive64), broken / 100) << P::name();
+        for (size_t i = 0; i < fx64.size(); ++i) {
+            EXPECT_NEAR(fxRef[i], fx64[i], fp64Tolerance * scale) << P::name() << " particle " << i;
+            EXPECT_NEAR(fyRef[i], fy64[i], fp64Tolerance * scale) << P::name() << " particle " << i;
+        }
+
+        for (caep::BondKernel::SimdLevel level : {caep::BondKernel::AVX2, caep::BondKernel::AVX512}) {
+            if (!caep::BondKernel::isSupported(level)) {
+                continue;
+            }
+            std::vector<uint64_t> alive;
+            std::vector<double> fx, fy, dmg;
+            fixture.run(fixture.geometryFloat, caep::BondKernel::select<P>(level), scr0, alive, fx, fy, dmg);
+            EXPECT_EQ(alive, aliveRef) << P::name() << " " << caep::BondKernel::name(level);
+            EXPECT_EQ(dmg, dmgRef) << P::name() << " " << caep::BondKernel::name(level);
+            for (size_t i = 0; i < fx.size(); ++i) {
+                EXPECT_NEAR(fx[i], fxRef[i], simdTolerance * scale) << P::name() << " particle " << i;
+                EXPECT_NEAR(fy[i], fyRef[i], simdTolerance * scale) << P::name() << " particle " << i;
+            }
+        }
+    }
+
+} // namespace
+
+TEST(BondKernel, AliveBits)
+{
+    std::vector<uint64_t> alive(3, ~uint64_t(0));
+
+    caep::clearAliveBits(alive.data(), 62, 0x5); // 跨越第 0、1 个字
+    EXPECT_EQ(caep::loadAliveBits(alive.data(), 60, 8), 0xebu);
+    EXPECT_EQ(caep::loadAliveBits(alive.data(), 64, 4), 0xeu);
+
+    caep::clearAliveBits(alive.data(), 128, 0xff);
+    EXPECT_EQ(caep::loadAliveBits(alive.data(), 126, 8), 0x3u);
+}
+
+TEST(BondKernel, Avx2MatchesScalar)
+{
+    expectMatchesScalar(caep::BondKernel::AVX2);
+}
+
+TEST(BondKernel, Avx512MatchesScalar)
+{
+    expectMatchesScalar(caep::BondKernel::AVX512);
+}
+
+TEST(BondKernel, HalfBondMatchesScalar)
+{
+    const double scr0 = 0.02;
+    KernelFixture fixture(48);
+
+    // 末尾 3 行粒子不参与力计算, 只作为邻居 (对应边界粒子)
+    const int numActive = static_cast<int>(fixture.points.size()) - 3 * 48;
+
+    std::vector<uint64_t> aliveRef, alive;
+    std::vector<double> fxRef, fyRef, dmgRef, fx, fy, dmg;
+    fixture.run(caep::computeBondForcesScalar, scr0, aliveRef, fxRef, fyRef, dmgRef, numActive);
+
+    caep::HalfBondKernel kernel;
+    ASSERT_EQ(kernel.init(fixture.bonds, numActive), NO_ERROR);
+
+    size_t activeBonds = fixture.bonds.begin(numActive);
+    EXPECT_LT(kernel.numPairs(), activeBonds);
+    EXPECT_GT(2 * kernel.numPairs(), activeBonds);
+
+    caep::BondKernelArgs args = fixture.makeArgs(scr0, alive, fx, fy, dmg);
+    kernel.computePairs(args, 0, numActive / 3);
+    kernel.computePairs(args, numActive / 3, numActive);
+    kernel.gather(args, 0, numActive / 3);
+    kernel.gather(args, numActive / 3, numActive);
+
+    // 累加顺序与逐键计算相同, 结果逐位一致
+    EXPECT_EQ(alive, aliveRef);
+    EXPECT_EQ(fx, fxRef);
+    EXPECT_EQ(fy, fyRef);
+    EXPECT_EQ(dmg, dmgRef);
+}
+
+TEST(BondKernel, IncrementalDamage)
+{
+    const double scr0 = 0.02;
+    KernelFixture fixture(48);
+
+    std::vector<uint64_t> alive;
+    std::vector<double> fx, fy, dmg;
+    fixture.run(caep::computeBondForcesScalar, scr0, alive, fx, fy, dmg);
+
+    // 增量损伤与按有效键比例重新统计的结果只有舍入差异
+    size_t damaged = 0;
+    for (size_t i = 0; i < fixture.points.size(); ++i) {
+        double dmgpar1 = 0.0, dmgpar2 = 0.0;
+        for (size_t b = fixture.bonds.begin(i); b < fixture.bonds.end(i); ++b) {
+            bool a = (alive[b >> 6] >> (b & 63)) & 1;
+            dmgpar1 += (a ? 1.0 : 0.0) * fixture.vol * fixture.geometry.fac()[b];
+            dmgpar2 += fixture.vol * fixture.geometry.fac()[b];
+        }
+        EXPECT_NEAR(dmg[i], 1.0 - dmgpar1 / dmgpar2, 1e-14) << "particle " << i;
+        damaged += dmg[i] > 0.0 ? 1 : 0;
+    }
+    EXPECT_GT(damaged, 0u);
+
+    // 有新断键的粒子即损伤大于 0 的粒子, 再次收集时为空
+    std::vector<int> changed;
+    fixture.damage.collectChanged(changed);
+    ASSERT_EQ(changed.size(), damaged);
+    for (int i : changed) {
+        EXPECT_GT(dmg[i], 0.0) << "particle " << i;
+    }
+    changed.clear();
+    fixture.damage.collectChanged(changed);
+    EXPECT_TRUE(changed.empty());
+
+    // 由已有断键重新建立时得到相同的损伤
+    caep::BondTable bonds = fixture.bonds;
+    std::copy(alive.begin(), alive.end(), bonds.aliveMask());
+    std::vector<double> dmgInit(dmg.size(), 0.0);
+    caep::DamageTracker tracker;
+    ASSERT_EQ(tracker.init(bonds, fixture.geometry.fac(), fixture.vol, static_cast<int>(dmg.size()), dmgInit.data()), NO_ERROR);
+    for (size_t i = 0; i < dmg.size(); ++i) {
+        EXPECT_NEAR(dmgInit[i], dmg[i], 1e-15) << "particle " << i;
+    }
+}
+
+TEST(BondKernel, CompactionSkipsBrokenBonds)
+{
+    KernelFixture fixture(48);
+    const int n = static_cast<int>(fixture.points.size());
+
+    std::vector<uint64_t> alive;
+    std::vector<double> fx, fy, dmg;
+    fixture.run(caep::computeBondForcesScalar, 0.02, alive, fx, fy, dmg);
+    std::copy(alive.begin(), alive.end(), fixture.bonds.aliveMask());
+
+    // 不再断键时, 压缩前后的键力与损伤相同
+    std::vector<uint64_t> aliveRef;
+    std::vector<double> fxRef, fyRef, dmgRef;
+    fixture.run(caep::computeBondForcesScalar, 1e9, aliveRef, fxRef, fyRef, dmgRef);
+
+    caep::BondTable original = fixture.bonds;
+    size_t removed = fixture.bonds.compact(0, n / 3, fixture.geometry.fields())
+        + fixture.bonds.compact(n / 3, n, fixture.geometry.fields());
+    EXPECT_EQ(removed, fixture.damage.numBroken());
+    EXPECT_GT(removed, 0u);
+    EXPECT_EQ(fixture.bonds.compact(0, n, fixture.geometry.fields()), 0u);
+
+    // 有效键按原顺序位于区间前部, 断键位于 liveEnd 之后
+    for (int i = 0; i < n; ++i) {
+        std::vector<int> live;
+        for (size_t b = original.begin(i); b < original.end(i); ++b) {
+            if (original.isAlive(b)) {
+                live.push_back(original.neighbor(b));
+            }
+        }
+        ASSERT_EQ(fixture.bonds.liveEnd(i) - fixture.bonds.begin(i), live.size()) << "particle " << i;
+        for (size_t k = 0; k < live.size(); ++k) {
+            EXPECT_EQ(fixture.bonds.neighbor(fixture.bonds.begin(i) + k), live[k]);
+            EXPECT_TRUE(fixture.bonds.isAlive(fixture.bonds.begin(i) + k));
+        }
+        for (size_t b = fixture.bonds.liveEnd(i); b < fixture.bonds.end(i); ++b) {
+            EXPECT_FALSE(fixture.bonds.isAlive(b));
+        }
+    }
+
+    // 逐键计算跳过的断键不参与求和, 标量版本逐位一致
+    std::vector<uint64_t> aliveCompact;
+    std::vector<double> fxCompact, fyCompact, dmgCompact;
+    fixture.run(caep::computeBondForcesScalar, 1e9, aliveCompact, fxCompact, fyCompact, dmgCompact);
+    EXPECT_EQ(fxCompact, fxRef);
+    EXPECT_EQ(fyCompact, fyRef);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_NEAR(dmgCompact[i], dmgRef[i], 1e-15) << "particle " << i;
+    }
+}
+
+TEST(BondKernel, MixedPrecision)
+{
+    expectPrecisionMatches<caep::PrecisionMixed>(1e-12, 1e-3);
+}
+
+TEST(BondKernel, Fp32Precision)
+{
+    expectPrecisionMatches<caep::PrecisionFp32>(1e-5, 1e-3);
+}
+
+TEST(BondKernel, ThreeDimensional)
+{
+    const double scr0 = 0.02;
+    KernelFixture fixture(48);
+    const int n = static_cast<int>(fixture.points.size());
+
+    std::vector<uint64_t> aliveRef;
+    std::vector<double> fxRef, fyRef, dmgRef;
+    fixture.run(caep::computeBondForcesScalar, scr0, aliveRef, fxRef, fyRef, dmgRef);
+
+    // 同一平面点阵分别放在 xy 与 xz 平面内, 三维核函数与二维断键一致, 面内力只有键几何舍入带来的差异
+    for (int plane = 1; plane <= 2; ++plane) {
+        std::vector<caep::Vec3> points;
+        std::vector<double> disp[3], force[3];
+        for (int d = 0; d < 3; ++d) {
+            disp[d].assign(n, 0.0);
+            force[d].assign(n, 1.0);
+        }
+        for (int i = 0; i < n; ++i) {
+            caep::Vec3 p(fixture.points[i].x, 0.0, 0.0);
+            (plane == 1 ? p.y : p.z) = fixture.points[i].y;
+            points.push_back(p);
+            disp[0][i] = fixture.dispx[i];
+            disp[plane][i] = fixture.dispy[i];
+        }
+        caep::BondGeometry geometry;
+        std::vector<std::vector<double>> fncst(3, std::vector<double>(n, 1.0));
+        double dx = 1.0 / 48;
+        ASSERT_EQ(geometry.build(fixture.bonds, points, fncst, {3.015 * dx, dx, 1.0e11, fixture.vol, nullptr}), NO_ERROR);
+
+        std::vector<uint64_t> alive;
+        std::vector<double> fx, fy, dmg;
+        caep::BondKernelArgs args = fixture.makeArgs(scr0, alive, fx, fy, dmg);
+        args.rx = geometry.rx();
+        args.ry = geometry.ry();
+        args.rz = geometry.rz();
+        args.idist = geometry.idist();
+        args.coef = geometry.coef();
+        args.dispx = disp[0].data();
+        args.dispy = disp[1].data();
+        args.dispz = disp[2].data();
+        args.forcex = force[0].data();
+        args.forcey = force[1].data();
+        args.forcez = force[2].data();
+        caep::computeBondForces3Scalar(args, 0, n / 3);
+        caep::computeBondForces3Scalar(args, n / 3, n);
+
+        EXPECT_EQ(alive, aliveRef) << "plane " << plane;
+        EXPECT_EQ(dmg, dmgRef) << "plane " << plane;
+        double scale = 0.0;
+        for (int i = 0; i < n; ++i) {
+            scale = std::max(scale, std::max(std::abs(fxRef[i]), std::abs(fyRef[i])));
+        }
+        for (int i = 0; i < n; ++i) {
+            EXPECT_NEAR(force[0][i], fxRef[i], 1e-12 * scale) << "particle " << i;
+            EXPECT_NEAR(force[plane][i], fyRef[i], 1e-12 * scale) << "particle " << i;
+            EXPECT_EQ(force[3 - plane][i], 0.0) << "particle " << i;
+        }
+    }
+}
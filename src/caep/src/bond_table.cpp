@@ -0,0 +1,129 @@
+#include "bond_table.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    BondTable::BondTable()
+    {
+        ;
+    }
+
+    int BondTable::init(const std::vector<int>& numfam, std::vector<int>&& nodefam)
+    {
+        clear();
+
+        mOffsets.resize(numfam.size() + 1, 0);
+        for (size_t i = 0; i < numfam.size(); ++i) {
+            ASSERTER_WITH_RET(numfam[i] >= 0, ERROR_INVALID_PARAMETER);
+            mOffsets[i + 1] = mOffsets[i] + numfam[i];
+        }
+        mLiveEnds.assign(mOffsets.begin() + 1, mOffsets.end());
+        ASSERTER_WITH_INFO(mOffsets.back() == nodefam.size(), ERROR_INVALID_PARAMETER,
+            "bond count mismatch: numfam sums to %zu, nodefam has %zu", mOffsets.back(), nodefam.size());
+
+        mNeighbors.assign(nodefam.begin(), nodefam.end());
+        std::vector<int>().swap(nodefam);
+
+        // 末尾多余的位也置 1, 不影响按键编号的访问
+        mAlive.assign((mNeighbors.size() + 63) / 64, ~uint64_t(0));
+
+        return NO_ERROR;
+    }
+
+    int BondTable::setStorage(const std::string& directory)
+    {
+        if (!directory.empty()) {
+            ASSERTER_WITH_INFO(memory::isMapSupported(), ERROR_NOT_SUPPORTED, "memory-mapped bond storage is not supported");
+            ASSERTER_WITH_INFO(memory::isMapDirectory(directory), ERROR_INVALID_PARAMETER,
+                "cannot create bond storage files in '%s'", directory.c_str());
+        }
+        mNeighbors = BondArray<int>(memory::XMapAllocator<int>(directory));
+        mAlive = BondArray<uint64_t>(memory::XMapAllocator<uint64_t>(directory));
+        return NO_ERROR;
+    }
+
+    void BondTable::prefetch(int begin, int end) const
+    {
+        if (!isMapped() || begin >= end) {
+            return;
+        }
+        const size_t b0 = mOffsets[begin], b1 = mOffsets[end];
+        memory::adviseWillNeed(mNeighbors.data() + b0, (b1 - b0) * sizeof(int));
+        memory::adviseWillNeed(mAlive.data() + (b0 >> 6), ((b1 + 63) / 64 - (b0 >> 6)) * sizeof(uint64_t));
+    }
+
+    void BondTable::clear()
+    {
+        mOffsets.clear();
+        mNeighbors.clear();
+        mAlive.clear();
+        mLiveEnds.clear();
+    }
+
+    template<typename T>
+    size_t BondTable::compact(int begin, int end, const std::vector<T*>& fields)
+    {
+        size_t removed = 0;
+        std::vector<size_t> order;     // 压缩后的键顺序 (相对 begin(i) 的编号)
+        std::vector<T> scratch;
+        std::vector<int> scratchNeighbors;
+
+        for (int i = begin; i < end; ++i) {
+            const size_t b0 = mOffsets[i];
+            const size_t live = mLiveEnds[i] - b0;
+
+            order.clear();
+            for (size_t k = 0; k < live; ++k) {
+                if (isAliveAtomic(b0 + k)) {
+                    order.push_back(k);
+                }
+            }
+            const size_t numAlive = order.size();
+            if (numAlive == live) {
+                continue;
+            }
+            for (size_t k = 0; k < live; ++k) {
+                if (!isAliveAtomic(b0 + k)) {
+                    order.push_back(k);
+                }
+            }
+
+            scratchNeighbors.assign(mNeighbors.begin() + b0, mNeighbors.begin() + b0 + live);
+            for (size_t k = 0; k < live; ++k) {
+                mNeighbors[b0 + k] = scratchNeighbors[order[k]];
+            }
+            for (T* field : fields) {
+                scratch.assign(field + b0, field + b0 + live);
+                for (size_t k = 0; k < live; ++k) {
+                    field[b0 + k] = scratch[order[k]];
+                }
+            }
+
+            // 区间首尾的字可能与相邻粒子共享, 逐位以原子操作更新
+            for (size_t k = 0; k < live; ++k) {
+                size_t b = b0 + k;
+                uint64_t bit = uint64_t(1) << (b & 63);
+                if (k < numAlive) {
+                    __atomic_fetch_or(&mAlive[b >> 6], bit, __ATOMIC_RELAXED);
+                } else {
+                    __atomic_fetch_and(&mAlive[b >> 6], ~bit, __ATOMIC_RELAXED);
+                }
+            }
+
+            mLiveEnds[i] = b0 + numAlive;
+            removed += live - numAlive;
+        }
+
+        return removed;
+    }
+
+    template size_t BondTable::compact<float>(int begin, int end, const std::vector<float*>& fields);
+    template size_t BondTable::compact<double>(int begin, int end, const std::vector<double*>& fields);
+
+    size_t BondTable::sizeByByte() const
+    {
+        return (mOffsets.size() + mLiveEnds.size()) * sizeof(size_t) + mNeighbors.size() * sizeof(int) + mAlive.size() * sizeof(uint64_t);
+    }
+
+} // namespace caep
@@ -0,0 +1,65 @@
+#include "damage_tracker.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    DamageTracker::DamageTracker()
+        : mNumBroken(0)
+    {
+        ;
+    }
+
+    template<typename Real>
+    int DamageTracker::init(const BondTable& bonds, const Real* fac, double vol, int numActive, double* damage)
+    {
+        ASSERTER_WITH_RET(numActive >= 0 && static_cast<size_t>(numActive) <= bonds.numParticles(), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(fac != nullptr && damage != nullptr, ERROR_INVALID_PARAMETER);
+
+        clear();
+
+        mRefWeight.assign(numActive, 0.0);
+        mBrokenWeight.assign(numActive, 0.0);
+        for (int i = 0; i < numActive; ++i) {
+            // 与 breakBonds 相同, 按键顺序累加
+            for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                mRefWeight[i] += vol * fac[b];
+                if (!bonds.isAlive(b)) {
+                    mBrokenWeight[i] += vol * fac[b];
+                    ++mNumBroken;
+                }
+            }
+            damage[i] = (mRefWeight[i] > 1e-10) ? mBrokenWeight[i] / mRefWeight[i] : 0.0;
+        }
+        mSeenWeight = mBrokenWeight;
+
+        return NO_ERROR;
+    }
+
+    template int DamageTracker::init<float>(const BondTable& bonds, const float* fac, double vol, int numActive, double* damage);
+    template int DamageTracker::init<double>(const BondTable& bonds, const double* fac, double vol, int numActive, double* damage);
+
+    void DamageTracker::clear()
+    {
+        mRefWeight.clear();
+        mBrokenWeight.clear();
+        mSeenWeight.clear();
+        mNumBroken = 0;
+    }
+
+    void DamageTracker::collectChanged(std::vector<int>& changed)
+    {
+        for (size_t i = 0; i < mBrokenWeight.size(); ++i) {
+            if (mBrokenWeight[i] != mSeenWeight[i]) {
+                mSeenWeight[i] = mBrokenWeight[i];
+                changed.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    size_t DamageTracker::sizeByByte() const
+    {
+        return (mRefWeight.size() + mBrokenWeight.size() + mSeenWeight.size()) * sizeof(double);
+    }
+
+} // namespace caep
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <limits>
+
+#define TAG_LOGGER "[CAEP]"
+#include "logger.h"
+
+#include "domain_decomposition.h"
+
+using namespace std;
+
+
+namespace caep {
+
+    DomainDecomposition::DomainDecomposition()
+        : mRank(0), mNumRanks(1), mLocal{0, 0, 0}, mGlobalIds(), mSend(), mRecv()
+    {
+        ;
+    }
+
+    template<typename Point>
+    int DomainDecomposition::init(const vector<Point>& points, const Layout& layout, int numRanks, int rank, double delta)
+    {
+        ASSERTER_WITH_RET(numRanks > 0 && rank >= 0 && rank < numRanks && delta > 0.0, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(layout.numInt > 0 && layout.numInt <= layout.numBottom && layout.numBottom <= layout.numTop
+            && static_cast<size_t>(layout.numTop) == points.size(), ERROR_INVALID_PARAMETER);
+        mRank = rank;
+        mNumRanks = numRanks;
+
+        // 1. 条带分界取内部粒子 x 坐标的分位数, rank r 拥有 cuts[r - 1] <= x < cuts[r] 的粒子
+        vector<double> xs(layout.numInt);
+        for (int i = 0; i < layout.numInt; ++i) {
+            xs[i] = points[i].x;
+        }
+        sort(xs.begin(), xs.end());
+        vector<double> cuts(numRanks - 1);
+        for (int r = 1; r < numRanks; ++r) {
+            cuts[r - 1] = xs[static_cast<size_t>(r) * layout.numInt / numRanks];
+        }
+        auto owner = [&cuts](double x) {
+            return static_cast<int>(upper_bound(cuts.begin(), cuts.end(), x) - cuts.begin());
+        };
+        vector<int> owned(numRanks, 0);
+        for (double x : xs) {
+            ++owned[owner(x)];
+        }
+        ASSERTER_WITH_INFO(*min_element(owned.begin(), owned.end()) > 0, ERROR_INVALID_PARAMETER,
+            "%d ranks leave some rank without particles", numRanks);
+
+        // 2. rank q 的幽灵层: 其他 rank 拥有的、x 距 q 拥有粒子的 x 范围不超过 delta 的粒子 (略微放宽以容忍舍入)
+        vector<double> lo(numRanks, numeric_limits<double>::infinity());
+        vector<double> hi(numRanks, -numeric_limits<double>::infinity());
+        for (const Point& p : points) {
+            int q = owner(p.x);
+            lo[q] = min(lo[q], p.x);
+            hi[q] = max(hi[q], p.x);
+        }
+        const double band = delta * (1.0 + 1e-9);
+        auto isGhostOf = [&](int q, double x) {
+            return owner(x) != q && x >= lo[q] - band && x <= hi[q] + band;
+        };
+
+        // 3. 局部编号: 拥有的粒子按分段, 之后为幽灵粒子
+        mGlobalIds.clear();
+        const int segments[] = {layout.numInt, layout.numBottom, layout.numTop};
+        int* localEnds[] = {&mLocal.numInt, &mLocal.numBottom, &mLocal.numTop};
+        for (int s = 0, g = 0; s < 3; ++s) {
+            for (; g < segments[s]; ++g) {
+                if (owner(points[g].x) == rank) {
+                    mGlobalIds.push_back(g);
+                }
+            }
+            *localEnds[s] = static_cast<int>(mGlobalIds.size());
+        }
+
+        mSend.assign(numRanks, vector<int>());
+        mRecv.assign(numRanks, vector<int>());
+        for (int l = 0; l < mLocal.numTop; ++l) {
+            double x = points[mGlobalIds[l]].x;
+            for (int q = 0; q < numRanks; ++q) {
+                if (isGhostOf(q, x)) {
+                    mSend[q].push_back(l);
+                }
+            }
+        }
+        for (int g = 0; g < layout.numTop; ++g) {
+            double x = points[g].x;
+            if (isGhostOf(rank, x)) {
+                mRecv[owner(x)].push_back(static_cast<int>(mGlobalIds.size()));
+                mGlobalIds.push_back(g);
+            }
+        }
+        return NO_ERROR;
+    }
+
+    void DomainDecomposition::localizeFamilies(vector<int>& numfam, vector<int>& pointfam, vector<int>& nodefam) const
+    {
+        if (mNumRanks == 1) {
+            return; // 局部编号即全局编号, 邻居已按编号升序
+        }
+
+        const int n = static_cast<int>(numfam.size());
+        vector<int> num(n, 0), point(n, 0), node;
+        node.reserve(nodefam.size());
+        for (int i = 0; i < n; ++i) {
+            point[i] = static_cast<int>(node.size());
+            if (i >= mLocal.numTop) {
+                continue;
+            }
+            auto first = nodefam.begin() + pointfam[i];
+            node.insert(node.end(), first, first + numfam[i]);
+            sort(node.begin() + point[i], node.end(), [this](int a, int b) { return mGlobalIds[a] < mGlobalIds[b]; });
+            num[i] = numfam[i];
+        }
+        numfam.swap(num);
+        pointfam.swap(point);
+        nodefam.swap(node);
+    }
+
+    template int DomainDecomposition::init<Vec2>(const vector<Vec2>&, const Layout&, int, int, double);
+    template int DomainDecomposition::init<Vec3>(const vector<Vec3>&, const Layout&, int, int, double);
+
+} // namespace caep
@@ -0,0 +1,122 @@
+#include <vector>
+#include <set>
+#include "domain_decomposition.h"
+#include "neighbor_search.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    // 12 x 6 的内部粒子 (间距 1), 上下各 2 层边界粒子
+    std::vector<caep::Vec2> plate(caep::DomainDecomposition::Layout& layout)
+    {
+        std::vector<caep::Vec2> points;
+        auto rows = [&points](double y0, double dy, int count) {
+            for (int j = 0; j < count; ++j) {
+                for (int i = 0; i < 12; ++i) {
+                    points.push_back({0.5 + i, y0 + j * dy});
+                }
+            }
+        };
+        rows(0.5, 1.0, 6);
+        layout.numInt = static_cast<int>(points.size());
+        rows(-0.5, -1.0, 2);
+        layout.numBottom = static_cast<int>(points.size());
+        rows(6.5, 1.0, 2);
+        layout.numTop = static_cast<int>(points.size());
+        return points;
+    }
+
+} // namespace
+
+TEST(DomainDecomposition, Strips)
+{
+    const double delta = 2.01;
+    caep::DomainDecomposition::Layout layout;
+    std::vector<caep::Vec2> points = plate(layout);
+
+    // 单个 rank: 局部编号即全局编号
+    caep::DomainDecomposition single;
+    ASSERT_EQ(single.init(points, layout, 1, 0, delta), NO_ERROR);
+    EXPECT_EQ(single.numGhosts(), 0);
+    EXPECT_EQ(single.local().numTop, layout.numTop);
+    for (int i = 0; i < layout.numTop; ++i) {
+        EXPECT_EQ(single.globalIds()[i], i);
+    }
+
+    const int ranks = 3;
+    std::vector<caep::DomainDecomposition> domains(ranks);
+    std::vector<int> owners(layout.numTop, -1);
+    for (int r = 0; r < ranks; ++r) {
+        caep::DomainDecomposition& domain = domains[r];
+        ASSERT_EQ(domain.init(points, layout, ranks, r, delta), NO_ERROR);
+        EXPECT_EQ(domain.local().numInt, layout.numInt / ranks);    // 每个条带 4 列
+        for (int l = 0; l < domain.local().numTop; ++l) {
+            int g = domain.globalIds()[l];
+            EXPECT_EQ(owners[g], -1) << "particle " << g << " owned twice";
+            owners[g] = r;
+            // 分段保持: 内部粒子在前, 底部与顶部边界粒子在后
+            EXPECT_EQ(g < layout.numInt, l < domain.local().numInt);
+            EXPECT_EQ(g >= layout.numBottom, l >= domain.local().numBottom);
+        }
+
+        // 拥有粒子的邻居都在局部粒子中, 幽灵粒子都在作用域内
+        std::set<int> local(domain.globalIds().begin(), domain.globalIds().end());
+        std::set<int> reached;
+        for (int l = 0; l < domain.local().numTop; ++l) {
+            const caep::Vec2& p = points[domain.globalIds()[l]];
+            for (int g = 0; g < layout.numTop; ++g) {
+                double dx = points[g].x - p.x, dy = points[g].y - p.y;
+                if (dx * dx + dy * dy <= delta * delta) {
+                    EXPECT_EQ(local.count(g), 1u) << "rank " << r << " misses neighbor " << g;
+                    reached.insert(g);
+                }
+            }
+        }
+        for (int l = domain.local().numTop; l < domain.numLocal(); ++l) {
+            EXPECT_EQ(reached.count(domain.globalIds()[l]), 1u) << "rank " << r << " has a needless ghost";
+        }
+    }
+    for (int g = 0; g < layout.numTop; ++g) {
+        EXPECT_NE(owners[g], -1) << "particle " << g << " not owned";
+    }
+
+    // 发送与接收一一对应
+    for (int p = 0; p < ranks; ++p) {
+        for (int q = 0; q < ranks; ++q) {
+            const std::vector<int>& send = domains[p].sendList(q);
+            const std::vector<int>& recv = domains[q].recvList(p);
+            ASSERT_EQ(send.size(), recv.size()) << p << " -> " << q;
+            for (size_t k = 0; k < send.size(); ++k) {
+                EXPECT_EQ(domains[p].globalIds()[send[k]], domains[q].globalIds()[recv[k]]);
+                EXPECT_GE(recv[k], domains[q].local().numTop);
+            }
+        }
+    }
+    EXPECT_TRUE(domains[0].sendList(2).empty());    // 条带宽 4 > delta, 不相邻的条带不交换
+
+    // 局部邻域搜索: 幽灵粒子不建键, 邻居按全局编号排序
+    const caep::DomainDecomposition& middle = domains[1];
+    std::vector<caep::Vec2> localPoints;
+    for (int g : middle.globalIds()) {
+        localPoints.push_back(points[g]);
+    }
+    std::vector<int> numfam, pointfam, nodefam;
+    ASSERT_EQ(caep::NeighborSearch::buildByCellList(localPoints, delta, numfam, pointfam, nodefam), NO_ERROR);
+    middle.localizeFamilies(numfam, pointfam, nodefam);
+    for (int l = 0; l < middle.numLocal(); ++l) {
+        if (l >= middle.local().numTop) {
+            EXPECT_EQ(numfam[l], 0);
+            continue;
+        }
+        EXPECT_GT(numfam[l], 0);
+        for (int k = 1; k < numfam[l]; ++k) {
+            EXPECT_LT(middle.globalIds()[nodefam[pointfam[l] + k - 1]], middle.globalIds()[nodefam[pointfam[l] + k]]);
+        }
+    }
+    EXPECT_EQ(pointfam.back() + numfam.back(), static_cast<int>(nodefam.size()));
+
+    // rank 数超过列数
+    caep::DomainDecomposition tooMany;
+    EXPECT_EQ(tooMany.init(points, layout, 13, 0, delta), ERROR_INVALID_PARAMETER);
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include "dual_horizon.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    DualHorizon::DualHorizon()
+        : mSpacing(), mHorizon(), mBondConstant(), mVolume(), mRefVolume(0.0)
+    {
+        ;
+    }
+
+    int DualHorizon::init(const std::vector<double>& spacing, const Params& params)
+    {
+        ASSERTER_WITH_RET(params.ratio > 0.0 && params.refVolume > 0.0, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(params.bondConstant != nullptr && params.volume != nullptr, ERROR_INVALID_PARAMETER);
+
+        const size_t n = spacing.size();
+        mSpacing = spacing;
+        mHorizon.resize(n);
+        mBondConstant.resize(n);
+        mVolume.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERTER_WITH_RET(spacing[i] > 0.0, ERROR_INVALID_PARAMETER);
+            mHorizon[i] = params.ratio * spacing[i];
+            mBondConstant[i] = params.bondConstant(params.youngModulus, mHorizon[i], params.thick);
+            mVolume[i] = params.volume(spacing[i], params.thick);
+        }
+        mRefVolume = params.refVolume;
+        return NO_ERROR;
+    }
+
+    void DualHorizon::clear()
+    {
+        mSpacing.clear();
+        mHorizon.clear();
+        mBondConstant.clear();
+        mVolume.clear();
+        mRefVolume = 0.0;
+    }
+
+    template<typename Real>
+    int DualHorizon::massScale(const BondTable& bonds, const Real* idist, int numParticles, std::vector<double>& scale) const
+    {
+        ASSERTER_WITH_RET(idist != nullptr && numParticles >= 0, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(static_cast<size_t>(numParticles) <= std::min(bonds.numParticles(), mSpacing.size()), ERROR_INVALID_PARAMETER);
+
+        scale.assign(numParticles, 1.0);
+        for (int i = 0; i < numParticles; ++i) {
+            double dual = 0.0, own = 0.0;
+            for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                int j = bonds.neighbor(b);
+                dual += stiffness(i, j, idist[b]) / idist[b];
+                own += mBondConstant[i] * BondGeometry::volumeCorrection(idist[b], mHorizon[i], mSpacing[j]) * mVolume[j] / idist[b];
+            }
+            if (own > 0.0) {
+                scale[i] = std::max(1.0, dual / own);
+            }
+        }
+        return NO_ERROR;
+    }
+
+    template int DualHorizon::massScale<float>(const BondTable&, const float*, int, std::vector<double>&) const;
+    template int DualHorizon::massScale<double>(const BondTable&, const double*, int, std::vector<double>&) const;
+
+} // namespace caep
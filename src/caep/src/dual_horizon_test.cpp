@@ -0,0 +1,89 @@
+#include <cmath>
+#include <vector>
+#include "dual_horizon.h"
+#include "dimension.h"
+#include "neighbor_search.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    // 左侧 16 x 16 的细粒子 (间距 1), 右侧 8 x 8 的粗粒子 (间距 2)
+    struct TwoLevels {
+        std::vector<caep::Vec2>     points;
+        std::vector<double>         spacing;
+        std::vector<double>         idist;
+        caep::BondTable             bonds;
+
+        TwoLevels(double ratio)
+        {
+            auto block = [this](double x0, double h, int n) {
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        points.push_back({x0 + (j + 0.5) * h, (i + 0.5) * h});
+                        spacing.push_back(h);
+                    }
+                }
+            };
+            block(0.0, 1.0, 16);
+            block(16.0, 2.0, 8);
+
+            std::vector<double> horizons;
+            for (double h : spacing) {
+                horizons.push_back(ratio * h);
+            }
+            std::vector<int> numfam, pointfam, nodefam;
+            EXPECT_EQ(caep::NeighborSearch::buildByCellList(points, horizons, numfam, pointfam, nodefam), NO_ERROR);
+            EXPECT_EQ(bonds.init(numfam, std::move(nodefam)), NO_ERROR);
+            for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+                for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                    idist.push_back(caep::distance(points[i], points[bonds.neighbor(b)]));
+                }
+            }
+        }
+    };
+
+} // namespace
+
+TEST(DualHorizon, Stiffness)
+{
+    const double ratio = 3.015, E = 192.0e9, thick = 0.0005;
+    const double bc = caep::Dimension<2>::bondConstant(E, ratio, thick), vol = caep::Dimension<2>::volume(1.0, thick);
+    TwoLevels grid(ratio);
+    caep::DualHorizon dual;
+    ASSERT_EQ(dual.init(grid.spacing, {ratio, E, thick, vol,
+        &caep::Dimension<2>::bondConstant, &caep::Dimension<2>::volume}), NO_ERROR);
+    EXPECT_DOUBLE_EQ(dual.bondConstant(0), bc);
+
+    const int n = static_cast<int>(grid.points.size());
+    for (int i = 0; i < n; ++i) {
+        for (size_t b = grid.bonds.begin(i); b < grid.bonds.end(i); ++b) {
+            int j = grid.bonds.neighbor(b);
+            double r = grid.idist[b];
+            // 作用于两端的力大小相等
+            double vi = caep::Dimension<2>::volume(dual.spacing(i), thick), vj = caep::Dimension<2>::volume(dual.spacing(j), thick);
+            EXPECT_NEAR(dual.stiffness(i, j, r) * vi, dual.stiffness(j, i, r) * vj, 1e-12 * dual.stiffness(i, j, r) * vi);
+            // 细粒子之间即原键型模型
+            if (i < 256 && j < 256) {
+                double fac = caep::BondGeometry::volumeCorrection(r, ratio, 1.0);
+                EXPECT_NEAR(dual.stiffness(i, j, r), bc * vol * fac, 1e-12 * bc * vol);
+                EXPECT_NEAR(dual.volumeFactor(i, j, r), fac, 1e-12);
+            }
+        }
+    }
+
+    // 远离交界的细粒子不放大质量, 靠近细粒子的粗粒子需要放大
+    std::vector<double> scale;
+    ASSERT_EQ(dual.massScale(grid.bonds, grid.idist.data(), n, scale), NO_ERROR);
+    ASSERT_EQ(scale.size(), static_cast<size_t>(n));
+    EXPECT_DOUBLE_EQ(scale[8 * 16 + 2], 1.0);
+    EXPECT_GT(scale[256 + 4 * 8], 1.0);
+    for (double s : scale) {
+        EXPECT_GE(s, 1.0);
+    }
+
+    EXPECT_NE(dual.init(std::vector<double>(4, 0.0), {ratio, E, thick, vol,
+        &caep::Dimension<2>::bondConstant, &caep::Dimension<2>::volume}), NO_ERROR);
+    dual.clear();
+    EXPECT_TRUE(dual.empty());
+}
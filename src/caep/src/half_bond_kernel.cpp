@@ -0,0 +1,129 @@
+#include <cmath>
+#include <algorithm>
+#include "half_bond_kernel.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    HalfBondKernel::HalfBondKernel()
+    {
+        ;
+    }
+
+    int HalfBondKernel::init(const BondTable& bonds, int numActive)
+    {
+        ASSERTER_WITH_RET(numActive >= 0 && static_cast<size_t>(numActive) <= bonds.numParticles(), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(bonds.numBonds() < static_cast<size_t>(INT32_MAX), ERROR_INVALID_PARAMETER);
+
+        clear();
+
+        mPairOffsets.resize(numActive + 1, 0);
+        mBondPair.assign(bonds.numBonds(), 0);
+
+        // 正向键 i -> j (i < j) 按键编号顺序成为粒子对
+        for (int i = 0; i < numActive; ++i) {
+            for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                if (bonds.neighbor(b) > i) {
+                    mBondPair[b] = static_cast<int32_t>(mPairBond.size());
+                    mPairBond.push_back(b);
+                }
+            }
+            mPairOffsets[i + 1] = mPairBond.size();
+        }
+
+        // 反向键 i -> j (j < i) 在 j 的邻居中查找 i
+        for (int i = 0; i < numActive; ++i) {
+            for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                int j = bonds.neighbor(b);
+                if (j > i) {
+                    continue;
+                }
+                ASSERTER_WITH_INFO(j != i, ERROR_INVALID_PARAMETER, "particle %d is bonded to itself", i);
+
+                const int* first = bonds.neighbors() + bonds.begin(j);
+                const int* last = bonds.neighbors() + bonds.end(j);
+                const int* it = std::lower_bound(first, last, i);
+                ASSERTER_WITH_INFO(it != last && *it == i, ERROR_INVALID_PARAMETER,
+                    "bond %d -> %d has no reverse bond", i, j);
+
+                mBondPair[b] = ~mBondPair[bonds.begin(j) + (it - first)];
+            }
+        }
+
+        mForceX.resize(mPairBond.size());
+        mForceY.resize(mPairBond.size());
+        mStretch.resize(mPairBond.size());
+        mValid.resize(mPairBond.size());
+
+        return NO_ERROR;
+    }
+
+    void HalfBondKernel::clear()
+    {
+        mPairOffsets.clear();
+        mPairBond.clear();
+        mBondPair.clear();
+        mForceX.clear();
+        mForceY.clear();
+        mStretch.clear();
+        mValid.clear();
+    }
+
+    void HalfBondKernel::computePairs(const BondKernelArgs& args, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            for (size_t p = mPairOffsets[i]; p < mPairOffsets[i + 1]; ++p) {
+                size_t b = mPairBond[p];
+                int cnode = args.neighbors[b];
+                double ux = args.rx[b] + (args.dispx[cnode] - args.dispx[i]); // 变形后相对位置
+                double uy = args.ry[b] + (args.dispy[cnode] - args.dispy[i]);
+                double nlength = std::sqrt(ux*ux + uy*uy);
+                double stretch = (nlength - args.idist[b]) / args.idist[b];
+
+                bool valid = nlength > 1e-10;
+                double t = valid ? args.coef[b] * stretch / nlength : 0.0;
+                mForceX[p] = ux * t;
+                mForceY[p] = uy * t;
+                mStretch[p] = stretch;
+                mValid[p] = valid ? 1 : 0;
+            }
+        }
+    }
+
+    void HalfBondKernel::gather(const BondKernelArgs& args, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            double fx = 0.0, fy = 0.0;
+            const bool breakable = args.breakable[i] != 0;
+
+            for (size_t b = args.offsets[i]; b < args.offsets[i + 1]; ++b) {
+                int32_t v = mBondPair[b];
+                size_t p = static_cast<size_t>(v >= 0 ? v : ~v);
+
+                uint32_t alive = loadAliveBits(args.alive, b, 1);
+                if (alive && mValid[p]) {
+                    // 反向键的键力取反 (取反是精确的, 与逐键计算逐位一致)
+                    fx += v >= 0 ? mForceX[p] : -mForceX[p];
+                    fy += v >= 0 ? mForceY[p] : -mForceY[p];
+                }
+
+                // 判断是否断裂（临界拉伸+区域限制）
+                if (alive && breakable && std::abs(mStretch[p]) > args.scr0) {
+                    breakBonds(args, i, b, 1);
+                }
+            }
+
+            args.forcex[i] = fx;
+            args.forcey[i] = fy;
+        }
+    }
+
+    size_t HalfBondKernel::sizeByByte() const
+    {
+        return mPairOffsets.size() * sizeof(size_t) + mPairBond.size() * sizeof(size_t)
+            + mBondPair.size() * sizeof(int32_t)
+            + (mForceX.size() + mForceY.size() + mStretch.size()) * sizeof(double) + mValid.size();
+    }
+
+} // namespace caep
@@ -0,0 +1,207 @@
+#include <cmath>
+#include <algorithm>
+#include "lattice_stencil.h"
+#include "lattice_stencil.impl.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    LatticeStencil::LatticeStencil()
+        : mKernel(computeStencilScalar), mWidth(0), mNumRegular(0)
+    {
+        ;
+    }
+
+    int LatticeStencil::init(const std::vector<Vec2>& coord, double dx, double delta, const BondTable& bonds, int numActive)
+    {
+        const int n = static_cast<int>(coord.size());
+        ASSERTER_WITH_RET(dx > 0.0 && delta > 0.0, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(bonds.numParticles() == coord.size(), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(numActive >= 0 && numActive <= n, ERROR_INVALID_PARAMETER);
+
+        clear();
+        mCell.assign(n, -1);
+        mRegular.assign(numActive, 0);
+        if (n == 0) {
+            return NO_ERROR;
+        }
+
+        // 点阵原点与格点坐标, 偏离格点超过 1e-6 dx 的粒子不在点阵上
+        Vec2 lo = coord[0];
+        for (const Vec2& p : coord) {
+            lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+        }
+        std::vector<int64_t> gi(n), gj(n);
+        int64_t ncols = 0, nrows = 0;
+        for (int i = 0; i < n; ++i) {
+            gj[i] = std::llround((coord[i].x - lo.x) / dx);
+            gi[i] = std::llround((coord[i].y - lo.y) / dx);
+            bool onLattice = std::abs(coord[i].x - lo.x - gj[i] * dx) <= 1e-6 * dx
+                && std::abs(coord[i].y - lo.y - gi[i] * dx) <= 1e-6 * dx;
+            if (!onLattice) {
+                gi[i] = -1;
+                continue;
+            }
+            ncols = std::max(ncols, gj[i] + 1);
+            nrows = std::max(nrows, gi[i] + 1);
+        }
+
+        // 模板: 作用域内的格点偏移, 按 di (y)、dj (x) 升序, 与光栅编号下邻居列表的顺序一致
+        const int radius = static_cast<int>(delta / dx);
+        mWidth = static_cast<int>(ncols) + 2 * radius;
+        const int64_t height = nrows + 2 * radius;
+        for (int di = -radius; di <= radius; ++di) {
+            for (int dj = -radius; dj <= radius; ++dj) {
+                Vec2 r = {dj * dx, di * dx};
+                double idist = r.magnitude();
+                if ((di == 0 && dj == 0) || idist > delta) {
+                    continue;
+                }
+                mOffsets.push_back(int64_t(di) * mWidth + dj);
+                mRx.push_back(r.x);
+                mRy.push_back(r.y);
+                mIdist.push_back(idist);
+                mInvIdist.push_back(1.0 / idist);
+            }
+        }
+
+        // 占用标记 (格点上的粒子编号)
+        std::vector<int> occupant(mWidth * height, -1);
+        for (int i = 0; i < n; ++i) {
+            if (gi[i] < 0) {
+                continue;
+            }
+            int64_t cell = (gi[i] + radius) * mWidth + (gj[i] + radius);
+            if (occupant[cell] < 0) {
+                occupant[cell] = i;
+                mCell[i] = cell;
+            }
+        }
+
+        // 规则粒子: 邻居列表与模板逐项对应
+        const int k = stencilSize();
+        if (k <= MAX_STENCIL) {
+            for (int i = 0; i < numActive; ++i) {
+                if (mCell[i] < 0 || bonds.count(i) != k) {
+                    continue;
+                }
+                bool regular = true;
+                for (int s = 0; s < k && regular; ++s) {
+                    regular = occupant[mCell[i] + mOffsets[s]] == bonds.neighbor(bonds.begin(i) + s);
+                }
+                mRegular[i] = regular ? 1 : 0;
+                mNumRegular += regular ? 1 : 0;
+            }
+        }
+
+        mGridX.assign(occupant.size(), 0.0);
+        mGridY.assign(occupant.size(), 0.0);
+
+        mKernel = select(BondKernel::detect());
+
+        return NO_ERROR;
+    }
+
+    void LatticeStencil::clear()
+    {
+        mWidth = 0;
+        mCell.clear();
+        mRegular.clear();
+        mNumRegular = 0;
+        mOffsets.clear();
+        mRx.clear();
+        mRy.clear();
+        mIdist.clear();
+        mInvIdist.clear();
+        mGridX.clear();
+        mGridY.clear();
+    }
+
+    size_t LatticeStencil::refresh(const BondTable& bonds)
+    {
+        size_t demoted = 0;
+        for (size_t i = 0; i < mRegular.size(); ++i) {
+            if (mRegular[i] && bonds.liveEnd(static_cast<int>(i)) != bonds.end(static_cast<int>(i))) {
+                mRegular[i] = 0;
+                ++demoted;
+            }
+        }
+        mNumRegular -= demoted;
+        return demoted;
+    }
+
+    void LatticeStencil::scatter(const double* dispx, const double* dispy, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            if (mCell[i] >= 0) {
+                mGridX[mCell[i]] = dispx[i];
+                mGridY[mCell[i]] = dispy[i];
+            }
+        }
+    }
+
+    void computeStencilScalar(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end)
+    {
+        computeStencil(stencil, args, fallback, begin, end);
+    }
+
+#if !defined(CAEP_HAVE_AVX2)
+    void computeStencilAvx2(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end)
+    {
+        computeStencil(stencil, args, fallback, begin, end);
+    }
+#endif
+
+#if !defined(CAEP_HAVE_AVX512)
+    void computeStencilAvx512(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end)
+    {
+        computeStencil(stencil, args, fallback, begin, end);
+    }
+#endif
+
+    StencilKernelFunc LatticeStencil::select(BondKernel::SimdLevel level)
+    {
+        if (!BondKernel::isSupported(level)) {
+            return computeStencilScalar;
+        }
+
+        switch (level) {
+            case BondKernel::AVX2:
+                return computeStencilAvx2;
+            case BondKernel::AVX512:
+                return computeStencilAvx512;
+            default:
+                return computeStencilScalar;
+        }
+    }
+
+    void LatticeStencil::compute(const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end) const
+    {
+        mKernel(kernelArgs(), args, fallback, begin, end);
+    }
+
+    StencilKernelArgs LatticeStencil::kernelArgs() const
+    {
+        StencilKernelArgs stencil;
+        stencil.size = stencilSize();
+        stencil.offsets = mOffsets.data();
+        stencil.rx = mRx.data();
+        stencil.ry = mRy.data();
+        stencil.idist = mIdist.data();
+        stencil.invIdist = mInvIdist.data();
+        stencil.cell = mCell.data();
+        stencil.regular = mRegular.data();
+        stencil.gridx = mGridX.data();
+        stencil.gridy = mGridY.data();
+        return stencil;
+    }
+
+    size_t LatticeStencil::sizeByByte() const
+    {
+        return mCell.size() * sizeof(int64_t) + mRegular.size() + mOffsets.size() * sizeof(int64_t)
+            + (mRx.size() + mRy.size() + mIdist.size() + mInvIdist.size()) * sizeof(double)
+            + (mGridX.size() + mGridY.size()) * sizeof(double);
+    }
+
+} // namespace caep
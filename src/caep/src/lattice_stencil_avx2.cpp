@@ -0,0 +1,15 @@
+#if defined(CAEP_HAVE_AVX2)
+
+#include "lattice_stencil.impl.h"
+
+
+namespace caep {
+
+    void computeStencilAvx2(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end)
+    {
+        computeStencil(stencil, args, fallback, begin, end);
+    }
+
+} // namespace caep
+
+#endif // CAEP_HAVE_AVX2
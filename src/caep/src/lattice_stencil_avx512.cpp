@@ -0,0 +1,87 @@
+#if defined(CAEP_HAVE_AVX512)
+
+#include <immintrin.h>
+#include "lattice_stencil.impl.h"
+
+
+namespace caep {
+
+    // 同一行连续 8 个规则粒子占满一个 512 位寄存器: 邻居位移连续读取, 键系数按步长 k 收集,
+    // 每个通道仍按模板顺序累加, 结果与逐个粒子计算逐位一致
+    static void computeStencilBlockAvx512(const StencilKernelArgs& stencil, const BondKernelArgs& args, int i)
+    {
+        const int k = stencil.size;
+        const uint32_t full = k >= 32 ? ~0u : ((1u << k) - 1);
+        const size_t b0 = args.offsets[i];
+        const double* gx = stencil.gridx + stencil.cell[i];
+        const double* gy = stencil.gridy + stencil.cell[i];
+        const double* coef = args.coef + b0;
+
+        const __m512d eps = _mm512_set1_pd(1e-10);
+        const __m512d scr0 = _mm512_set1_pd(args.scr0);
+        const __m256i lanes = _mm256_mullo_epi32(_mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0), _mm256_set1_epi32(k));
+
+        // 有效位转置为按模板项的通道掩码 (通常全部有效)
+        uint32_t alive[STENCIL_LANES];
+        bool allAlive = true;
+        for (int l = 0; l < STENCIL_LANES; ++l) {
+            alive[l] = loadAliveBits(args.alive, b0 + size_t(l) * k, k);
+            allAlive = allAlive && alive[l] == full;
+        }
+        __mmask8 aliveByStencil[LatticeStencil::MAX_STENCIL];
+        for (int s = 0; s < k; ++s) {
+            unsigned m = 0xff;
+            if (!allAlive) {
+                m = 0;
+                for (int l = 0; l < STENCIL_LANES; ++l) {
+                    m |= ((alive[l] >> s) & 1u) << l;
+                }
+            }
+            aliveByStencil[s] = static_cast<__mmask8>(m);
+        }
+
+        const __m512d dxi = _mm512_loadu_pd(gx);
+        const __m512d dyi = _mm512_loadu_pd(gy);
+        __m512d fx = _mm512_setzero_pd(), fy = _mm512_setzero_pd();
+        __mmask8 overByStencil[LatticeStencil::MAX_STENCIL];
+        __mmask8 anyOver = 0;
+
+        for (int s = 0; s < k; ++s) {
+            __m512d ux = _mm512_add_pd(_mm512_set1_pd(stencil.rx[s]), _mm512_sub_pd(_mm512_loadu_pd(gx + stencil.offsets[s]), dxi));
+            __m512d uy = _mm512_add_pd(_mm512_set1_pd(stencil.ry[s]), _mm512_sub_pd(_mm512_loadu_pd(gy + stencil.offsets[s]), dyi));
+            __m512d nlength = _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(ux, ux), _mm512_mul_pd(uy, uy)));
+            __m512d stretch = _mm512_mul_pd(_mm512_sub_pd(nlength, _mm512_set1_pd(stencil.idist[s])), _mm512_set1_pd(stencil.invIdist[s]));
+
+            __m512d c = _mm512_i32gather_pd(lanes, coef + s, 8);
+            __mmask8 valid = _mm512_mask_cmp_pd_mask(aliveByStencil[s], nlength, eps, _CMP_GT_OQ);
+            __m512d t = _mm512_maskz_div_pd(valid, _mm512_mul_pd(c, stretch), nlength);
+            fx = _mm512_mask_add_pd(fx, valid, fx, _mm512_mul_pd(ux, t));
+            fy = _mm512_mask_add_pd(fy, valid, fy, _mm512_mul_pd(uy, t));
+
+            overByStencil[s] = _mm512_mask_cmp_pd_mask(aliveByStencil[s], _mm512_abs_pd(stretch), scr0, _CMP_GT_OQ);
+            anyOver |= overByStencil[s];
+        }
+
+        _mm512_storeu_pd(args.forcex + i, fx);
+        _mm512_storeu_pd(args.forcey + i, fy);
+
+        // 判断是否断裂（临界拉伸+区域限制）
+        for (int l = 0; l < STENCIL_LANES; ++l) {
+            if (((anyOver >> l) & 1) && args.breakable[i + l]) {
+                uint32_t broken = 0;
+                for (int s = 0; s < k; ++s) {
+                    broken |= ((overByStencil[s] >> l) & 1u) << s;
+                }
+                breakBonds(args, i + l, b0 + size_t(l) * k, broken);
+            }
+        }
+    }
+
+    void computeStencilAvx512(const StencilKernelArgs& stencil, const BondKernelArgs& args, BondKernelFunc fallback, int begin, int end)
+    {
+        computeStencil(stencil, args, fallback, begin, end, computeStencilBlockAvx512);
+    }
+
+} // namespace caep
+
+#endif // CAEP_HAVE_AVX512
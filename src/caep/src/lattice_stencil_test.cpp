@@ -0,0 +1,153 @@
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "neighbor_search.h"
+#include "bond_table.h"
+#include "bond_geometry.h"
+#include "bond_kernel.h"
+#include "lattice_stencil.h"
+#include "damage_tracker.h"
+#include "gtest/gtest.h"
+
+
+TEST(LatticeStencil, MatchesScalar)
+{
+    // 带孔方板 (光栅编号), 其后为上方 3 行不参与力计算的边界粒子
+    const int ndiv = 40;
+    const double dx = 1.0 / ndiv;
+    const double delta = 3.015 * dx;
+    std::vector<caep::Vec2> points;
+    for (int i = 0; i < ndiv; ++i) {
+        for (int j = 0; j < ndiv; ++j) {
+            double x = -0.5 + (j + 0.5) * dx, y = -0.5 + (i + 0.5) * dx;
+            if (std::sqrt(x*x + y*y) > 0.1) {
+                points.push_back({x, y});
+            }
+        }
+    }
+    const int numActive = static_cast<int>(points.size());
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < ndiv; ++j) {
+            points.push_back({-0.5 + (j + 0.5) * dx, 0.5 + (i + 0.5) * dx});
+        }
+    }
+    const int n = static_cast<int>(points.size());
+
+    caep::BondTable bonds;
+    {
+        std::vector<int> numfam, pointfam, nodefam;
+        ASSERT_EQ(caep::NeighborSearch::buildByCellList(points, delta, numfam, pointfam, nodefam), NO_ERROR);
+        ASSERT_EQ(bonds.init(numfam, std::move(nodefam)), NO_ERROR);
+    }
+    caep::BondGeometry geometry;
+    std::vector<double> fncst(n, 1.0);
+    const double vol = dx * dx * dx;
+    ASSERT_EQ(geometry.build(bonds, points, fncst, fncst, {delta, dx, 1.0e11, vol, nullptr}), NO_ERROR);
+
+    caep::LatticeStencil stencil;
+    ASSERT_EQ(stencil.init(points, dx, delta, bonds, numActive), NO_ERROR);
+    EXPECT_EQ(stencil.stencilSize(), 28);
+    // 距外边界与孔边 3 层以外的粒子为规则粒子
+    EXPECT_GT(stencil.numRegular(), size_t(numActive) / 2);
+    EXPECT_LT(stencil.numRegular(), size_t(numActive));
+
+    std::vector<double> dispx(n), dispy(n);
+    std::vector<uint8_t> breakable(n);
+    std::srand(3);
+    for (int i = 0; i < n; ++i) {
+        double noise = (std::rand() % 16 == 0) ? 0.3 * dx : 1e-4 * dx;
+        dispx[i] = 1e-3 * points[i].x + noise * (std::rand() / (double)RAND_MAX - 0.5);
+        dispy[i] = -3e-4 * points[i].y + noise * (std::rand() / (double)RAND_MAX - 0.5);
+        breakable[i] = std::abs(points[i].y) <= 0.25 ? 1 : 0;
+    }
+
+    auto run = [&](caep::StencilKernelFunc kernel, std::vector<uint64_t>& alive, std::vector<double>& fx, std::vector<double>& fy, std::vector<double>& dmg) {
+        alive.assign(bonds.aliveMask(), bonds.aliveMask() + (bonds.numBonds() + 63) / 64);
+        fx.assign(n, 0.0);
+        fy.assign(n, 0.0);
+        dmg.assign(n, 0.0);
+        caep::DamageTracker damage;
+        damage.init(bonds, geometry.fac(), vol, numActive, dmg.data());
+
+        caep::BondKernelArgs args;
+        args.offsets = bonds.offsets();
+        args.ends = bonds.liveEnds();
+        args.neighbors = bonds.neighbors();
+        args.alive = alive.data();
+        args.rx = geometry.rx();
+        args.ry = geometry.ry();
+        args.idist = geometry.idist();
+        args.fac = geometry.fac();
+        args.coef = geometry.coef();
+        args.dispx = dispx.data();
+        args.dispy = dispy.data();
+        args.breakable = breakable.data();
+        args.scr0 = 0.02;
+        args.vol = vol;
+        args.forcex = fx.data();
+        args.forcey = fy.data();
+        args.brokenWeight = damage.brokenWeight();
+        args.refWeight = damage.refWeight();
+        args.damage = dmg.data();
+        args.numBroken = damage.brokenCounter();
+
+        if (kernel != nullptr) {
+            stencil.scatter(dispx.data(), dispy.data(), 0, n);
+            kernel(stencil.kernelArgs(), args, caep::computeBondForcesScalar, 0, numActive);
+        } else {
+            caep::computeBondForcesScalar(args, 0, numActive);
+        }
+    };
+
+    std::vector<uint64_t> aliveRef, alive;
+    std::vector<double> fxRef, fyRef, dmgRef, fx, fy, dmg;
+    run(nullptr, aliveRef, fxRef, fyRef, dmgRef);
+    run(caep::computeStencilScalar, alive, fx, fy, dmg);
+
+    // 模板几何为精确点阵偏移, 与坐标相减得到的几何只有舍入差异
+    EXPECT_EQ(alive, aliveRef);
+    EXPECT_EQ(dmg, dmgRef);
+    double scale = 0.0;
+    for (int i = 0; i < numActive; ++i) {
+        scale = std::max(scale, std::max(std::abs(fxRef[i]), std::abs(fyRef[i])));
+    }
+    for (int i = 0; i < numActive; ++i) {
+        EXPECT_NEAR(fx[i], fxRef[i], 1e-9 * scale) << "particle " << i;
+        EXPECT_NEAR(fy[i], fyRef[i], 1e-9 * scale) << "particle " << i;
+    }
+
+    // 各指令集版本与标量版本逐位一致
+    for (caep::BondKernel::SimdLevel level : {caep::BondKernel::AVX2, caep::BondKernel::AVX512}) {
+        if (!caep::BondKernel::isSupported(level)) {
+            continue;
+        }
+        std::vector<uint64_t> aliveSimd;
+        std::vector<double> fxSimd, fySimd, dmgSimd;
+        run(caep::LatticeStencil::select(level), aliveSimd, fxSimd, fySimd, dmgSimd);
+        EXPECT_EQ(aliveSimd, alive) << caep::BondKernel::name(level);
+        EXPECT_EQ(fxSimd, fx) << caep::BondKernel::name(level);
+        EXPECT_EQ(fySimd, fy) << caep::BondKernel::name(level);
+        EXPECT_EQ(dmgSimd, dmg) << caep::BondKernel::name(level);
+    }
+
+    // 键表压缩后有断键的规则粒子改为逐键计算
+    std::copy(alive.begin(), alive.end(), bonds.aliveMask());
+    ASSERT_GT(bonds.compact(0, numActive, geometry.fields()), 0u);
+    size_t numRegular = stencil.numRegular();
+    EXPECT_GT(stencil.refresh(bonds), 0u);
+    EXPECT_LT(stencil.numRegular(), numRegular);
+
+    run(nullptr, aliveRef, fxRef, fyRef, dmgRef);
+    for (caep::BondKernel::SimdLevel level : {caep::BondKernel::SCALAR, caep::BondKernel::AVX2, caep::BondKernel::AVX512}) {
+        if (!caep::BondKernel::isSupported(level)) {
+            continue;
+        }
+        run(caep::LatticeStencil::select(level), alive, fx, fy, dmg);
+        EXPECT_EQ(alive, aliveRef) << caep::BondKernel::name(level);
+        for (int i = 0; i < numActive; ++i) {
+            EXPECT_NEAR(fx[i], fxRef[i], 1e-9 * scale) << "particle " << i;
+            EXPECT_NEAR(fy[i], fyRef[i], 1e-9 * scale) << "particle " << i;
+        }
+    }
+}
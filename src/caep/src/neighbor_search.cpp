@@ -0,0 +1,254 @@
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include "neighbor_search.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    namespace {
+
+        template<typename Point>
+        struct PointDim;
+
+        template<>
+        struct PointDim<Vec2> { static const int value = 2; };
+
+        template<>
+        struct PointDim<Vec3> { static const int value = 3; };
+
+        // 均匀网格搜索: 粒子 i 的邻居为距离不超过 radius(i) 的粒子, 网格尺寸取最小半径 delta,
+        // 粒子 i 遍历 radius(i) 覆盖的 (2 reach + 1)^Dim 个网格 (半径均为 delta 时为相邻的 3^Dim 个网格)
+        template<typename Point, typename Radius>
+        void searchCells(const std::vector<Point>& coord, double delta, Radius radius,
+            std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam)
+        {
+            const int DIM = PointDim<Point>::value;
+            const int n = static_cast<int>(coord.size());
+            numfam.assign(n, 0);
+            pointfam.assign(n, 0);
+            nodefam.clear();
+            if (n == 0) {
+                return;
+            }
+
+            // 计算包围盒
+            double lo[DIM], hi[DIM];
+            for (int d = 0; d < DIM; ++d) {
+                lo[d] = hi[d] = coord[0][d];
+            }
+            for (const Point& p : coord) {
+                for (int d = 0; d < DIM; ++d) {
+                    lo[d] = std::min(lo[d], p[d]);
+                    hi[d] = std::max(hi[d], p[d]);
+                }
+            }
+
+            // 网格尺寸略大于 delta, 保证舍入误差下作用域内的邻居仍落在遍历的网格内
+            // 粒子稀疏时放大网格, 避免空网格数远超粒子数
+            double cell = delta * (1.0 + 1e-9);
+            auto numCells = [&](double size) {
+                double cells = 1.0;
+                for (int d = 0; d < DIM; ++d) {
+                    cells *= (hi[d] - lo[d]) / size + 1.0;
+                }
+                return cells;
+            };
+            while (numCells(cell) > 4.0 * n + 1024.0) {
+                cell *= 2.0;
+            }
+            int nc[DIM];
+            int ncells = 1;
+            for (int d = 0; d < DIM; ++d) {
+                nc[d] = static_cast<int>((hi[d] - lo[d]) / cell) + 1;
+                ncells *= nc[d];
+            }
+
+            // 计数排序: 将粒子按网格分桶, 桶内保持粒子编号升序
+            // 网格编号按 x 最快变化: c = cx + nc[0] * (cy + nc[1] * cz)
+            std::vector<int> cellOf(n);
+            std::vector<int> cellStart(ncells + 1, 0);
+            for (int i = 0; i < n; ++i) {
+                int c = 0;
+                for (int d = DIM - 1; d >= 0; --d) {
+                    c = c * nc[d] + std::min(static_cast<int>((coord[i][d] - lo[d]) / cell), nc[d] - 1);
+                }
+                cellOf[i] = c;
+                cellStart[c + 1]++;
+            }
+            for (int c = 0; c < ncells; ++c) {
+                cellStart[c + 1] += cellStart[c];
+            }
+            std::vector<int> cellParticles(n);
+            std::vector<int> cursor(cellStart.begin(), cellStart.end() - 1);
+            for (int i = 0; i < n; ++i) {
+                cellParticles[cursor[cellOf[i]]++] = i;
+            }
+
+            // 遍历覆盖作用域的网格, 邻居按编号升序存储 (与两两比较的结果一致)
+            std::vector<int> family;
+            nodefam.reserve(static_cast<size_t>(n) * (DIM == 3 ? 128 : 32));
+            for (int i = 0; i < n; ++i) {
+                const double r = radius(i);
+                const int reach = std::max(static_cast<int>(std::ceil(r / cell)), 1);
+                int home[DIM], first[DIM], last[DIM], at[DIM];
+                for (int d = 0, c = cellOf[i]; d < DIM; ++d) {
+                    home[d] = c % nc[d];
+                    c /= nc[d];
+                    first[d] = std::max(home[d] - reach, 0);
+                    last[d] = std::min(home[d] + reach, nc[d] - 1);
+                    at[d] = first[d];
+                }
+
+                family.clear();
+                for (;;) {
+                    int c = 0;
+                    for (int d = DIM - 1; d >= 0; --d) {
+                        c = c * nc[d] + at[d];
+                    }
+                    for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+                        int j = cellParticles[k];
+                        if (i != j && distance(coord[i], coord[j]) <= r) {
+                            family.push_back(j);
+                        }
+                    }
+
+                    // 下一个网格 (x 最快变化)
+                    int d = 0;
+                    while (d < DIM && at[d] == last[d]) {
+                        at[d] = first[d];
+                        ++d;
+                    }
+                    if (d == DIM) {
+                        break;
+                    }
+                    ++at[d];
+                }
+                std::sort(family.begin(), family.end());
+
+                pointfam[i] = static_cast<int>(nodefam.size());
+                numfam[i] = static_cast<int>(family.size());
+                nodefam.insert(nodefam.end(), family.begin(), family.end());
+            }
+            nodefam.shrink_to_fit();
+        }
+
+        // 有向作用域 H_i 对称化为 H_i 与对偶作用域 {j : i in H_j} 的并集, 邻居按编号升序
+        void symmetrize(const std::vector<int>& num, const std::vector<int>& point, const std::vector<int>& node,
+            std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam)
+        {
+            const int n = static_cast<int>(num.size());
+
+            // 转置 (CSR): 按 i 升序追加, 各粒子的对偶作用域自然有序
+            std::vector<int> dualStart(n + 1, 0);
+            for (int j : node) {
+                dualStart[j + 1]++;
+            }
+            for (int i = 0; i < n; ++i) {
+                dualStart[i + 1] += dualStart[i];
+            }
+            std::vector<int> dual(node.size());
+            std::vector<int> cursor(dualStart.begin(), dualStart.end() - 1);
+            for (int i = 0; i < n; ++i) {
+                for (int k = point[i]; k < point[i] + num[i]; ++k) {
+                    dual[cursor[node[k]]++] = i;
+                }
+            }
+
+            numfam.assign(n, 0);
+            pointfam.assign(n, 0);
+            nodefam.clear();
+            nodefam.reserve(node.size() + node.size() / 4);
+            for (int i = 0; i < n; ++i) {
+                pointfam[i] = static_cast<int>(nodefam.size());
+                std::set_union(node.begin() + point[i], node.begin() + point[i] + num[i],
+                    dual.begin() + dualStart[i], dual.begin() + dualStart[i + 1], std::back_inserter(nodefam));
+                numfam[i] = static_cast<int>(nodefam.size()) - pointfam[i];
+            }
+            nodefam.shrink_to_fit();
+        }
+
+    } // namespace
+
+    template<typename Point>
+    int NeighborSearch::buildByCellList(const std::vector<Point>& coord, double delta,
+        std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam)
+    {
+        ASSERTER_WITH_RET(delta > 0.0, ERROR_INVALID_PARAMETER);
+
+        searchCells(coord, delta, [delta](int) { return delta; }, numfam, pointfam, nodefam);
+        return NO_ERROR;
+    }
+
+    template<typename Point>
+    int NeighborSearch::buildByCellList(const std::vector<Point>& coord, const std::vector<double>& horizons,
+        std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam)
+    {
+        ASSERTER_WITH_RET(horizons.size() == coord.size(), ERROR_INVALID_PARAMETER);
+        if (coord.empty()) {
+            numfam.clear();
+            pointfam.clear();
+            nodefam.clear();
+            return NO_ERROR;
+        }
+        const double delta = *std::min_element(horizons.begin(), horizons.end());
+        ASSERTER_WITH_RET(delta > 0.0, ERROR_INVALID_PARAMETER);
+
+        std::vector<int> num, point, node;
+        searchCells(coord, delta, [&horizons](int i) { return horizons[i]; }, num, point, node);
+        symmetrize(num, point, node, numfam, pointfam, nodefam);
+        return NO_ERROR;
+    }
+
+    template<typename Point>
+    int NeighborSearch::buildByBruteForce(const std::vector<Point>& coord, double delta,
+        std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam)
+    {
+        ASSERTER_WITH_RET(delta > 0.0, ERROR_INVALID_PARAMETER);
+
+        return buildByBruteForce(coord, std::vector<double>(coord.size(), delta), numfam, pointfam, nodefam);
+    }
+
+    template<typename Point>
+    int NeighborSearch::buildByBruteForce(const std::vector<Point>& coord, const std::vector<double>& horizons,
+        std::vector<int>& numfam, std::vector<int>& pointfam, std::vector<int>& nodefam)
+    {
+        ASSERTER_WITH_RET(horizons.size() == coord.size(), ERROR_INVALID_PARAMETER);
+
+        const int n = static_cast<int>(coord.size());
+        numfam.assign(n, 0);
+        pointfam.assign(n, 0);
+        nodefam.clear();
+
+        for (int i = 0; i < n; ++i) {
+            pointfam[i] = static_cast<int>(nodefam.size());
+            for (int j = 0; j < n; ++j) {
+                if (i != j && distance(coord[i], coord[j]) <= std::max(horizons[i], horizons[j])) {
+                    nodefam.push_back(j);
+                    numfam[i]++;
+                }
+            }
+        }
+
+        return NO_ERROR;
+    }
+
+    template int NeighborSearch::buildByCellList<Vec2>(const std::vector<Vec2>&, double,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+    template int NeighborSearch::buildByCellList<Vec3>(const std::vector<Vec3>&, double,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+    template int NeighborSearch::buildByCellList<Vec2>(const std::vector<Vec2>&, const std::vector<double>&,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+    template int NeighborSearch::buildByCellList<Vec3>(const std::vector<Vec3>&, const std::vector<double>&,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+    template int NeighborSearch::buildByBruteForce<Vec2>(const std::vector<Vec2>&, double,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+    template int NeighborSearch::buildByBruteForce<Vec3>(const std::vector<Vec3>&, double,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+    template int NeighborSearch::buildByBruteForce<Vec2>(const std::vector<Vec2>&, const std::vector<double>&,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+    template int NeighborSearch::buildByBruteForce<Vec3>(const std::vector<Vec3>&, const std::vector<double>&,
+        std::vector<int>&, std::vector<int>&, std::vector<int>&);
+
+} // namespace caep
@@ -0,0 +1,150 @@
+#include <cstdlib>
+#include <algorithm>
+#include "neighbor_search.h"
+#include "gtest/gtest.h"
+
+
+// 生成与 demo_hole 相同布局的带孔板粒子 (内部区域 + 上下边界层)
+static std::vector<caep::Vec2> makePlateWithHole(int ndivx, int ndivy, int nband, double length, double radius)
+{
+    std::vector<caep::Vec2> coord;
+    double dx = length / ndivx;
+    for (int i = 1; i <= ndivy; ++i) {
+        for (int j = 1; j <= ndivx; ++j) {
+            double x = -length/2 + dx/2 + (j-1)*dx;
+            double y = -length/2 + dx/2 + (i-1)*dx;
+            if (std::sqrt(x*x + y*y) > radius) {
+                coord.push_back({x, y});
+            }
+        }
+    }
+    for (int i = 1; i <= nband; ++i) {
+        for (int j = 1; j <= ndivx; ++j) {
+            coord.push_back({-length/2 + dx/2 + (j-1)*dx, -length/2 - dx/2 - (i-1)*dx});
+        }
+    }
+    for (int i = 1; i <= nband; ++i) {
+        for (int j = 1; j <= ndivx; ++j) {
+            coord.push_back({-length/2 + dx/2 + (j-1)*dx, length/2 + dx/2 + (i-1)*dx});
+        }
+    }
+    return coord;
+}
+
+template<typename Point>
+static void expectSameFamilies(const std::vector<Point>& coord, double delta)
+{
+    std::vector<int> numfamRef, pointfamRef, nodefamRef;
+    std::vector<int> numfam, pointfam, nodefam;
+
+    ASSERT_EQ(caep::NeighborSearch::buildByBruteForce(coord, delta, numfamRef, pointfamRef, nodefamRef), NO_ERROR);
+    ASSERT_EQ(caep::NeighborSearch::buildByCellList(coord, delta, numfam, pointfam, nodefam), NO_ERROR);
+
+    ASSERT_EQ(numfam, numfamRef);
+    ASSERT_EQ(pointfam, pointfamRef);
+    ASSERT_EQ(nodefam, nodefamRef);
+}
+
+TEST(NeighborSearch, PlateWithHole)
+{
+    double length = 0.05;
+    double dx = length / 40;
+    expectSameFamilies(makePlateWithHole(40, 40, 3, length, 0.005), 3.015 * dx);
+}
+
+TEST(NeighborSearch, ScatteredParticles)
+{
+    std::srand(2025);
+    std::vector<caep::Vec2> coord;
+    for (int i = 0; i < 2000; ++i) {
+        coord.push_back({std::rand() / (double)RAND_MAX, 0.3 * std::rand() / (double)RAND_MAX});
+    }
+    expectSameFamilies(coord, 0.05);
+    expectSameFamilies(coord, 0.001); // 网格远多于粒子
+}
+
+TEST(NeighborSearch, Degenerate)
+{
+    expectSameFamilies(std::vector<caep::Vec2>(), 1.0);
+    expectSameFamilies(std::vector<caep::Vec2>{{0.0, 0.0}}, 1.0);
+    expectSameFamilies(std::vector<caep::Vec2>{{0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}}, 1.0); // 重合点与恰好位于作用域边界的点
+}
+
+TEST(NeighborSearch, CubicLattice)
+{
+    // 12 x 10 x 8 的立方点阵, delta = 3.015 dx, 内部粒子的邻居数为 122
+    const double dx = 0.1;
+    std::vector<caep::Vec3> coord;
+    for (int k = 0; k < 8; ++k) {
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 12; ++j) {
+                coord.push_back({j * dx, i * dx, k * dx});
+            }
+        }
+    }
+    expectSameFamilies(coord, 3.015 * dx);
+
+    std::vector<int> numfam, pointfam, nodefam;
+    ASSERT_EQ(caep::NeighborSearch::buildByCellList(coord, 3.015 * dx, numfam, pointfam, nodefam), NO_ERROR);
+    EXPECT_EQ(numfam[(4 * 10 + 5) * 12 + 6], 122);
+
+    // 稀疏的三维散点
+    std::srand(2026);
+    std::vector<caep::Vec3> scattered;
+    for (int i = 0; i < 1500; ++i) {
+        scattered.push_back({std::rand() / (double)RAND_MAX, 0.5 * std::rand() / (double)RAND_MAX, 0.2 * std::rand() / (double)RAND_MAX});
+    }
+    expectSameFamilies(scattered, 0.08);
+    expectSameFamilies(scattered, 0.002);
+}
+
+TEST(NeighborSearch, DualHorizon)
+{
+    // 左半边间距 dx, 右半边间距 4 dx, 作用域半径 3.015 倍间距; 散点的作用域半径在 [0.01, 0.06) 内随机
+    const double dx = 0.01;
+    std::vector<caep::Vec2> coord;
+    std::vector<double> horizons;
+    for (int i = 0; i < 40; ++i) {
+        for (int j = 0; j < 40; ++j) {
+            coord.push_back({(j + 0.5) * dx, (i + 0.5) * dx});
+            horizons.push_back(3.015 * dx);
+        }
+    }
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            coord.push_back({0.4 + (j + 0.5) * 4 * dx, (i + 0.5) * 4 * dx});
+            horizons.push_back(3.015 * 4 * dx);
+        }
+    }
+    std::srand(2027);
+    for (int i = 0; i < 500; ++i) {
+        coord.push_back({std::rand() / (double)RAND_MAX, 1.0 + 0.3 * std::rand() / (double)RAND_MAX});
+        horizons.push_back(0.01 + 0.05 * std::rand() / (double)RAND_MAX);
+    }
+
+    std::vector<int> numfamRef, pointfamRef, nodefamRef;
+    std::vector<int> numfam, pointfam, nodefam;
+    ASSERT_EQ(caep::NeighborSearch::buildByBruteForce(coord, horizons, numfamRef, pointfamRef, nodefamRef), NO_ERROR);
+    ASSERT_EQ(caep::NeighborSearch::buildByCellList(coord, horizons, numfam, pointfam, nodefam), NO_ERROR);
+    ASSERT_EQ(numfam, numfamRef);
+    ASSERT_EQ(pointfam, pointfamRef);
+    ASSERT_EQ(nodefam, nodefamRef);
+
+    // 邻居关系对称, 细粒子的邻居包含作用域覆盖它的粗粒子
+    for (int i = 0; i < static_cast<int>(coord.size()); ++i) {
+        for (int k = pointfam[i]; k < pointfam[i] + numfam[i]; ++k) {
+            int j = nodefam[k];
+            EXPECT_TRUE(std::binary_search(nodefam.begin() + pointfam[j], nodefam.begin() + pointfam[j] + numfam[j], i));
+        }
+    }
+    const int fine = 20 * 40 + 35, coarse = 40 * 40 + 5 * 10;   // 相距 0.065: 在粗粒子的作用域内, 不在细粒子的作用域内
+    EXPECT_TRUE(std::binary_search(nodefam.begin() + pointfam[fine], nodefam.begin() + pointfam[fine] + numfam[fine], coarse));
+
+    std::vector<int> numfamUniform, pointfamUniform, nodefamUniform;
+    ASSERT_EQ(caep::NeighborSearch::buildByCellList(coord, std::vector<double>(coord.size(), 0.03),
+        numfam, pointfam, nodefam), NO_ERROR);
+    ASSERT_EQ(caep::NeighborSearch::buildByCellList(coord, 0.03, numfamUniform, pointfamUniform, nodefamUniform), NO_ERROR);
+    EXPECT_EQ(nodefam, nodefamUniform);
+    EXPECT_EQ(caep::NeighborSearch::buildByCellList(coord, std::vector<double>(3, 0.03), numfam, pointfam, nodefam),
+        ERROR_INVALID_PARAMETER);
+}
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cmath>
+#include "particle_order.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    // 在每两位之间插入一个 0 位
+    static inline uint64_t spreadBits(uint32_t v)
+    {
+        uint64_t x = v;
+        x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+        x = (x | (x << 8))  & 0x00ff00ff00ff00ffULL;
+        x = (x | (x << 4))  & 0x0f0f0f0f0f0f0f0fULL;
+        x = (x | (x << 2))  & 0x3333333333333333ULL;
+        x = (x | (x << 1))  & 0x5555555555555555ULL;
+        return x;
+    }
+
+    uint64_t ParticleOrder::mortonCode(uint32_t x, uint32_t y)
+    {
+        return spreadBits(x) | (spreadBits(y) << 1);
+    }
+
+    int ParticleOrder::sortByMorton(const std::vector<Vec2>& coord, size_t begin, size_t end, std::vector<int>& order)
+    {
+        ASSERTER_WITH_RET(order.size() == coord.size(), ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(begin <= end && end <= coord.size(), ERROR_INVALID_PARAMETER);
+        if (begin == end) {
+            return NO_ERROR;
+        }
+
+        Vec2 lo = coord[order[begin]], hi = lo;
+        for (size_t k = begin; k < end; ++k) {
+            const Vec2& p = coord[order[k]];
+            lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+            hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+        }
+
+        // 以相同比例量化两个方向, 保持曲线的各向同性
+        const double resolution = double(1u << 20);
+        double extent = std::max(hi.x - lo.x, hi.y - lo.y);
+        double scale = extent > 0.0 ? (resolution - 1.0) / extent : 0.0;
+
+        std::vector<std::pair<uint64_t, int>> keys(end - begin);
+        for (size_t k = begin; k < end; ++k) {
+            const Vec2& p = coord[order[k]];
+            uint32_t qx = static_cast<uint32_t>((p.x - lo.x) * scale);
+            uint32_t qy = static_cast<uint32_t>((p.y - lo.y) * scale);
+            keys[k - begin] = {mortonCode(qx, qy), order[k]};
+        }
+        std::stable_sort(keys.begin(), keys.end(),
+            [](const std::pair<uint64_t, int>& a, const std::pair<uint64_t, int>& b) { return a.first < b.first; });
+
+        for (size_t k = begin; k < end; ++k) {
+            order[k] = keys[k - begin].second;
+        }
+
+        return NO_ERROR;
+    }
+
+    void ParticleOrder::inverse(const std::vector<int>& order, std::vector<int>& rank)
+    {
+        rank.resize(order.size());
+        for (size_t k = 0; k < order.size(); ++k) {
+            rank[order[k]] = static_cast<int>(k);
+        }
+    }
+
+} // namespace caep
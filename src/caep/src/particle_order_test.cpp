@@ -0,0 +1,49 @@
+#include <numeric>
+#include <algorithm>
+#include "particle_order.h"
+#include "gtest/gtest.h"
+
+
+TEST(ParticleOrder, MortonCode)
+{
+    EXPECT_EQ(caep::ParticleOrder::mortonCode(0, 0), 0u);
+    EXPECT_EQ(caep::ParticleOrder::mortonCode(1, 0), 1u);
+    EXPECT_EQ(caep::ParticleOrder::mortonCode(0, 1), 2u);
+    EXPECT_EQ(caep::ParticleOrder::mortonCode(3, 3), 15u);
+    EXPECT_EQ(caep::ParticleOrder::mortonCode(0xffffffffu, 0), 0x5555555555555555ULL);
+}
+
+TEST(ParticleOrder, SortByMorton)
+{
+    // 4 x 4 方阵按光栅顺序生成, 其后附加两个不参与排序的粒子
+    std::vector<caep::Vec2> coord;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            coord.push_back({double(j), double(i)});
+        }
+    }
+    coord.push_back({10.0, 10.0});
+    coord.push_back({-10.0, -10.0});
+
+    std::vector<int> order(coord.size());
+    std::iota(order.begin(), order.end(), 0);
+    ASSERT_EQ(caep::ParticleOrder::sortByMorton(coord, 0, 16, order), NO_ERROR);
+
+    // Z 序
+    const int expected[] = {0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15, 16, 17};
+    EXPECT_TRUE(std::equal(order.begin(), order.end(), expected));
+
+    std::vector<int> rank;
+    caep::ParticleOrder::inverse(order, rank);
+    for (size_t k = 0; k < order.size(); ++k) {
+        EXPECT_EQ(rank[order[k]], static_cast<int>(k));
+    }
+
+    std::vector<caep::Vec2> permuted = coord;
+    caep::ParticleOrder::apply(order, permuted);
+    EXPECT_EQ(permuted[2].x, 0.0);
+    EXPECT_EQ(permuted[2].y, 1.0);
+    EXPECT_EQ(permuted[17].x, -10.0);
+
+    EXPECT_NE(caep::ParticleOrder::sortByMorton(coord, 0, 20, order), NO_ERROR);
+}
@@ -0,0 +1,43 @@
+#include <algorithm>
+#include "particle_state.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    template<int Dim>
+    constexpr size_t BasicParticleState<Dim>::ALIGNMENT;
+    template<int Dim>
+    constexpr size_t BasicParticleState<Dim>::PADDING;
+
+    template<int Dim>
+    BasicParticleState<Dim>::BasicParticleState()
+        : mSize(0), mCapacity(0)
+    {
+        ;
+    }
+
+    template<int Dim>
+    int BasicParticleState<Dim>::init(size_t n)
+    {
+        mSize = n;
+        mCapacity = (n + PADDING - 1) / PADDING * PADDING;
+
+        // 每个矢量场 Dim 个分量, 另加 1 个标量场 (损伤)
+        mData = memory::XBuffer<double>((Dim * NUM_FIELDS + 1) * mCapacity, ALIGNMENT);
+
+        return NO_ERROR;
+    }
+
+    template<int Dim>
+    void BasicParticleState<Dim>::zero(Field f)
+    {
+        // 各分量连续存放
+        double* base = field(f).x;
+        std::fill(base, base + Dim * mCapacity, 0.0);
+    }
+
+    template class BasicParticleState<2>;
+    template class BasicParticleState<3>;
+
+} // namespace caep
@@ -0,0 +1,175 @@
+#include <cmath>
+#include "pcg_solver.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    template<typename Real>
+    void BondJacobian<Real>::apply(const BasicBondKernelArgs<Real>& args, const double* px, const double* py,
+        double* qx, double* qy, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            double sx = 0.0, sy = 0.0;
+            for (size_t b = args.offsets[i]; b < args.ends[i]; ++b) {
+                if (loadAliveBits(args.alive, b, 1) == 0) {
+                    continue;
+                }
+                const int j = args.neighbors[b];
+                const double idist = args.idist[b];
+                const double ex = args.rx[b] / idist, ey = args.ry[b] / idist;
+                const double c = args.coef[b] / idist;
+                const double d = c * (ex * (px[i] - px[j]) + ey * (py[i] - py[j]));
+                sx += d * ex;
+                sy += d * ey;
+            }
+            qx[i] = sx;
+            qy[i] = sy;
+        }
+    }
+
+    template<typename Real>
+    void BondJacobian<Real>::diagonal(const BasicBondKernelArgs<Real>& args, double* dx, double* dy, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            double sx = 0.0, sy = 0.0;
+            for (size_t b = args.offsets[i]; b < args.ends[i]; ++b) {
+                if (loadAliveBits(args.alive, b, 1) == 0) {
+                    continue;
+                }
+                const double idist = args.idist[b];
+                const double ex = args.rx[b] / idist, ey = args.ry[b] / idist;
+                const double c = args.coef[b] / idist;
+                sx += c * ex * ex;
+                sy += c * ey * ey;
+            }
+            dx[i] = sx > 0.0 ? sx : 1.0;
+            dy[i] = sy > 0.0 ? sy : 1.0;
+        }
+    }
+
+    template<typename Real>
+    PcgSolver<Real>::PcgSolver()
+        : mN(0), mTile(framework::DeterministicReduce<1>::DEFAULT_TILE)
+    {
+        ;
+    }
+
+    template<typename Real>
+    int PcgSolver<Real>::init(int n, int numTotal)
+    {
+        ASSERTER_WITH_RET(n >= 0 && numTotal >= n, ERROR_INVALID_PARAMETER);
+
+        mN = n;
+        mRx.assign(n, 0.0);
+        mRy.assign(n, 0.0);
+        mZx.assign(n, 0.0);
+        mZy.assign(n, 0.0);
+        mPx.assign(numTotal, 0.0);
+        mPy.assign(numTotal, 0.0);
+        mQx.assign(n, 0.0);
+        mQy.assign(n, 0.0);
+        mDx.assign(n, 1.0);
+        mDy.assign(n, 1.0);
+
+        return NO_ERROR;
+    }
+
+    template<typename Real>
+    int PcgSolver<Real>::solve(const BasicBondKernelArgs<Real>& args, const double* bx, const double* by,
+        double* xx, double* xy, double tolerance, int maxIterations, Stats& stats)
+    {
+        ASSERTER_WITH_RET(tolerance >= 0.0 && maxIterations >= 0, ERROR_INVALID_PARAMETER);
+
+        const size_t n = static_cast<size_t>(mN);
+        double* rx = mRx.data(); double* ry = mRy.data();
+        double* zx = mZx.data(); double* zy = mZy.data();
+        double* px = mPx.data(); double* py = mPy.data();
+        double* qx = mQx.data(); double* qy = mQy.data();
+        double* dx = mDx.data(); double* dy = mDy.data();
+
+        // x = 0, r = b, z = M^-1 r, p = z
+        double sums[2];
+        int ret = mReduce2.run(n, [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[2]) {
+            BondJacobian<Real>::diagonal(args, dx, dy, static_cast<int>(_i), static_cast<int>(_i + _ti));
+            for (size_t i = _i; i < _i + _ti; ++i) {
+                xx[i] = 0.0;
+                xy[i] = 0.0;
+                rx[i] = bx[i];
+                ry[i] = by[i];
+                zx[i] = px[i] = rx[i] / dx[i];
+                zy[i] = py[i] = ry[i] / dy[i];
+                partial[0].add(rx[i] * zx[i] + ry[i] * zy[i]);
+                partial[1].add(rx[i] * rx[i] + ry[i] * ry[i]);
+            }
+        }, sums);
+        ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+
+        double rz = sums[0];
+        const double bnorm = std::sqrt(sums[1]);
+        stats.iterations = 0;
+        stats.residual = 0.0;
+        if (bnorm == 0.0) {
+            return NO_ERROR;
+        }
+
+        double rnorm = bnorm;
+        for (int it = 0; it < maxIterations && rnorm > tolerance * bnorm; ++it) {
+            // q = A p, p . q
+            double pq[1];
+            ret = mReduce1.run(n, [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[1]) {
+                BondJacobian<Real>::apply(args, px, py, qx, qy, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                for (size_t i = _i; i < _i + _ti; ++i) {
+                    partial[0].add(px[i] * qx[i] + py[i] * qy[i]);
+                }
+            }, pq);
+            ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+            ASSERTER_WITH_INFO(pq[0] > 0.0, ERROR_INVALID_PARAMETER, "stiffness is not positive definite (p.Ap = %g)", pq[0]);
+
+            // x += alpha p, r -= alpha q, z = M^-1 r
+            const double alpha = rz / pq[0];
+            ret = mReduce2.run(n, [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[2]) {
+                for (size_t i = _i; i < _i + _ti; ++i) {
+                    xx[i] += alpha * px[i];
+                    xy[i] += alpha * py[i];
+                    rx[i] -= alpha * qx[i];
+                    ry[i] -= alpha * qy[i];
+                    zx[i] = rx[i] / dx[i];
+                    zy[i] = ry[i] / dy[i];
+                    partial[0].add(rx[i] * zx[i] + ry[i] * zy[i]);
+                    partial[1].add(rx[i] * rx[i] + ry[i] * ry[i]);
+                }
+            }, sums);
+            ASSERTER_WITH_RET(ret == NO_ERROR, ret);
+
+            // p = z + beta p
+            const double beta = sums[0] / rz;
+            rz = sums[0];
+            rnorm = std::sqrt(sums[1]);
+            XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(n, mTile)
+                for (size_t i = _i; i < _i + _ti; ++i) {
+                    px[i] = zx[i] + beta * px[i];
+                    py[i] = zy[i] + beta * py[i];
+                }
+            XTHREAD_PARALLELIZE_END
+
+            stats.iterations = it + 1;
+        }
+        stats.residual = rnorm / bnorm;
+
+        return NO_ERROR;
+    }
+
+    template<typename Real>
+    size_t PcgSolver<Real>::sizeByByte() const
+    {
+        return (mRx.size() + mRy.size() + mZx.size() + mZy.size() + mPx.size() + mPy.size()
+            + mQx.size() + mQy.size() + mDx.size() + mDy.size()) * sizeof(double);
+    }
+
+    template class BondJacobian<float>;
+    template class BondJacobian<double>;
+    template class PcgSolver<float>;
+    template class PcgSolver<double>;
+
+} // namespace caep
@@ -0,0 +1,70 @@
+#include <vector>
+#include "pcg_solver.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    // x 方向的一维链: 内部粒子 0, 1, 2 (x = 1, 2, 3), 边界粒子 3 (x = 0) 与 4 (x = 4), 只与相邻粒子成键
+    struct Chain {
+        std::vector<size_t>     offsets = {0, 2, 4};
+        std::vector<size_t>     ends = {2, 4, 6};
+        std::vector<int>        neighbors = {3, 1, 0, 2, 1, 4};
+        std::vector<uint64_t>   alive = {0x3f};
+        std::vector<double>     rx = {-1.0, 1.0, -1.0, 1.0, -1.0, 1.0};
+        std::vector<double>     ry = std::vector<double>(6, 0.0);
+        std::vector<double>     idist = std::vector<double>(6, 1.0);
+        std::vector<double>     coef = std::vector<double>(6, 1.0);
+
+        caep::BondKernelArgs args()
+        {
+            caep::BondKernelArgs args = caep::BondKernelArgs();
+            args.offsets = offsets.data();
+            args.ends = ends.data();
+            args.neighbors = neighbors.data();
+            args.alive = alive.data();
+            args.rx = rx.data();
+            args.ry = ry.data();
+            args.idist = idist.data();
+            args.coef = coef.data();
+            return args;
+        }
+    };
+
+} // namespace
+
+TEST(PcgSolver, Chain)
+{
+    framework::Flow& flow = framework::Flow::get();
+    flow.deinit();
+    ASSERT_EQ(flow.init(2, 1), NO_ERROR);
+
+    Chain chain;
+    caep::BondKernelArgs args = chain.args();
+
+    // A = tridiag(-1, 2, -1), 边界粒子的分量不参与求解
+    std::vector<double> px = {1.0, 0.0, 0.0, 5.0, 5.0}, py(5, 0.0), qx(3), qy(3);
+    caep::BondJacobian<double>::apply(args, px.data(), py.data(), qx.data(), qy.data(), 0, 3);
+    EXPECT_DOUBLE_EQ(qx[0], 1.0 - 5.0 + 1.0);
+    EXPECT_DOUBLE_EQ(qx[1], -1.0);
+    EXPECT_DOUBLE_EQ(qx[2], -5.0);
+
+    caep::PcgSolver<double> pcg;
+    ASSERT_EQ(pcg.init(3, 5), NO_ERROR);
+    std::vector<double> bx = {1.0, 0.0, 0.0}, by(3, 0.0), xx(3), xy(3);
+    caep::PcgSolver<double>::Stats stats;
+    ASSERT_EQ(pcg.solve(args, bx.data(), by.data(), xx.data(), xy.data(), 1e-12, 10, stats), NO_ERROR);
+    EXPECT_LE(stats.iterations, 3);
+    EXPECT_NEAR(xx[0], 0.75, 1e-12);
+    EXPECT_NEAR(xx[1], 0.5, 1e-12);
+    EXPECT_NEAR(xx[2], 0.25, 1e-12);
+    EXPECT_DOUBLE_EQ(xy[0], 0.0);
+
+    // 断开粒子 0 与 1 之间的键: 粒子 0 只与边界相连
+    chain.alive[0] = 0x39;
+    ASSERT_EQ(pcg.solve(args, bx.data(), by.data(), xx.data(), xy.data(), 1e-12, 10, stats), NO_ERROR);
+    EXPECT_NEAR(xx[0], 1.0, 1e-12);
+    EXPECT_NEAR(xx[1], 0.0, 1e-12);
+
+    flow.deinit();
+}
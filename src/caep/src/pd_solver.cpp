@@ -0,0 +1,1363 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <string>
+#include <numeric>
+#include <limits>
+#include <algorithm>
+
+#define TAG_LOGGER "[CAEP]"
+#include "logger.h"
+
+#include "pd_solver.h"
+#include "neighbor_search.h"
+#include "particle_order.h"
+#include "precision.h"
+#include "step_traffic.h"
+#include "residual_monitor.h"
+#include "pcg_solver.h"
+#include "relaxation_integrator.h"
+#include "stable_time_step.h"
+#include "surface_correction.h"
+#include "timer.h"
+#include "xthread_flow.h"
+#include "xthread_reduce.h"
+
+using namespace std;
+
+#ifndef M_PI
+#define M_PI       3.14159265358979323846
+#endif
+
+
+namespace caep {
+
+    namespace {
+
+        // 按线程数划分粒子块，每个线程约4块以平衡负载
+        size_t tileOf(size_t range, size_t threads)
+        {
+            return max(range / (threads * 4), size_t(256));
+        }
+
+        // 每步内存流量模型：fused 为融合后的两遍扫描（力+断键+ADR求和，积分+边界条件）
+        // 损伤只在断键时更新，不计入每步流量
+        // regularBonds 为点阵模板覆盖的键数，其余键按逐键计算的数据流计；R 为键几何每个量的字节数，dim 为空间维数
+        StepTraffic stepTraffic(ForceEngine engine, bool fused, size_t numActive, size_t numTotal,
+            size_t numBonds, size_t numPairs, size_t regularBonds, double R, int dim)
+        {
+            const double D = sizeof(double);
+            const double bondStream = sizeof(int) + (dim + 2) * R + 1.0 / 8; // 邻居、rx/ry(/rz)/idist/coef、有效位
+            const size_t numBoundary = numTotal - numActive;
+            // 力计算：每个粒子读 offsets、breakable 与自身位移，写力
+            const double forceParticle = sizeof(size_t) + 1 + dim * D + dim * D;
+
+            StepTraffic traffic;
+            if (!fused) {
+                traffic.addPass("boundary", numBoundary, 2 * D);
+            }
+            if (engine == FORCE_ENGINE_HALF_BOND) {
+                traffic.addPass("pairs", numPairs, sizeof(size_t) + sizeof(int) + 4 * R + 3 * D + 1);
+                traffic.addPass("force", numBonds, sizeof(int32_t) + 1.0 / 8);
+                traffic.addToPass(numActive, forceParticle);
+            } else if (engine == FORCE_ENGINE_STENCIL) {
+                if (!fused) {
+                    traffic.addPass("scatter", numTotal, sizeof(int64_t) + 4 * D);
+                }
+                traffic.addPass("force", regularBonds, R + 1.0 / 8);
+                traffic.addToPass(numBonds - regularBonds, bondStream);
+                traffic.addToPass(numActive, forceParticle + sizeof(int64_t) + 1);
+            } else {
+                traffic.addPass("force", numBonds, bondStream);
+                traffic.addToPass(numActive, forceParticle);
+            }
+
+            // ADR：读位移、力、前步力、质量与前半步速度，融合时位移与力已在缓存中
+            if (fused) {
+                traffic.addToPass(numActive, 3 * dim * D);
+            } else {
+                traffic.addPass("adr", numActive, 5 * dim * D);
+            }
+
+            // 积分：读写位移与半步速度，读力与质量，写速度与前步力
+            traffic.addPass("update", numActive, 8 * dim * D);
+            if (fused) {
+                traffic.addToPass(numBoundary, 2 * D);
+                if (engine == FORCE_ENGINE_STENCIL) {
+                    traffic.addToPass(numTotal, sizeof(int64_t) + 2 * D);
+                }
+            }
+            return traffic;
+        }
+
+        // 按键力计算方式计算粒子 [begin, end) 的键力（双精度键几何，支持全部计算方式）
+        void computeForces(ForceEngine engine, BondKernelFunc kernel, HalfBondKernel& halfBondKernel,
+            const LatticeStencil& stencil, const BondKernelArgs& args, int begin, int end)
+        {
+            if (engine == FORCE_ENGINE_HALF_BOND) {
+                halfBondKernel.gather(args, begin, end);
+            } else if (engine == FORCE_ENGINE_STENCIL) {
+                stencil.compute(args, kernel, begin, end);
+            } else {
+                kernel(args, begin, end);
+            }
+        }
+
+        // 升序的粒子编号合并为连续区间 [first, second)
+        void toRuns(const vector<int>& particles, vector<pair<int, int>>& runs)
+        {
+            runs.clear();
+            for (int i : particles) {
+                if (!runs.empty() && runs.back().second == i) {
+                    ++runs.back().second;
+                } else {
+                    runs.push_back({i, i + 1});
+                }
+            }
+        }
+
+        void computePairs(HalfBondKernel& halfBondKernel, const BondKernelArgs& args, int begin, int end)
+        {
+            halfBondKernel.computePairs(args, begin, end);
+        }
+
+        // 单精度键几何只支持逐键计算（由 SimConfig::validate 检查）
+        template<typename Real>
+        void computeForces(ForceEngine, void (*kernel)(const BasicBondKernelArgs<Real>&, int, int), HalfBondKernel&,
+            const LatticeStencil&, const BasicBondKernelArgs<Real>& args, int begin, int end)
+        {
+            kernel(args, begin, end);
+        }
+
+        template<typename Real>
+        void computePairs(HalfBondKernel&, const BasicBondKernelArgs<Real>&, int, int)
+        {
+            ;
+        }
+
+        // Morton 重排与点阵模板只支持二维粒子（三维由 SimConfig::validate 拒绝）
+        int sortByMorton(const vector<Vec2>& coord, size_t begin, size_t end, vector<int>& order)
+        {
+            return ParticleOrder::sortByMorton(coord, begin, end, order);
+        }
+
+        int sortByMorton(const vector<Vec3>&, size_t, size_t, vector<int>&)
+        {
+            return ERROR_NOT_SUPPORTED;
+        }
+
+        int initStencil(LatticeStencil& stencil, const vector<Vec2>& coord, double dx, double delta, const BondTable& bonds,
+            int numActive)
+        {
+            return stencil.init(coord, dx, delta, bonds, numActive);
+        }
+
+        int initStencil(LatticeStencil&, const vector<Vec3>&, double, double, const BondTable&, int)
+        {
+            return ERROR_NOT_SUPPORTED;
+        }
+
+    } // namespace
+
+    template<typename P, int Dim, typename Transport>
+    PdSolver<P, Dim, Transport>::PdSolver(Transport* transport)
+        : mLocalTransport(), mTransport(transport != nullptr ? transport : &mLocalTransport),
+          mGlobalInt(0), mHaloChannel(-1), mGatherChannel(-1),
+          mDx(0.0), mDelta(0.0), mThick(0.0), mVol(0.0), mBc(0.0),
+          mTotInt(0), mTotBottom(0), mTotTop(0), mTotLocal(0),
+          mSimd(BondKernel::SCALAR), mKernel(nullptr), mKernelArgs(),
+          mCompactEnabled(false), mLiveBonds(0), mBrokenAtCompaction(0), mNumCompactions(0)
+    {
+        ;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::init(const SimConfig& config)
+    {
+        int retConfig = config.validate();
+        ASSERTER_WITH_RET(retConfig == NO_ERROR, retConfig);
+        mConfig = config;
+
+        // 物理参数初始化
+        mDx = mConfig.dx();                     // 粒子间距
+        mDelta = mConfig.horizon * mDx;         // 作用域半径
+        mThick = mDx;                           // 板厚度（二维）
+        mVol = Dimension<Dim>::volume(mDx, mThick);                                 // 单个粒子体积
+        mBc = Dimension<Dim>::bondConstant(mConfig.youngModulus, mDelta, mThick);   // 键常数
+
+        // 1. 生成粒子坐标（内部区域 + 边界区域），重排后划分区域，只保留本 rank 的粒子与幽灵粒子
+        if (mConfig.refineLevels > 0) {
+            generateGradedParticles();
+        } else {
+            generateParticles();
+        }
+        if (isRoot()) {
+            cout << "Particles" << (Dim == 3 ? " (3D)" : "") << ": " << mTotInt << " interior, " << mTotTop - mTotInt << " boundary" << endl;
+            if (!mSpacing.empty()) {
+                cout << "Refinement: " << mConfig.refineLevels << " levels, spacing " << mDx << " to "
+                     << mDx * (1 << mConfig.refineLevels) << " (dual horizon)" << endl;
+            }
+        }
+        int retOrder = reorderParticles();
+        ASSERTER_WITH_RET(retOrder == NO_ERROR, retOrder);
+        int retDomain = localizeParticles();
+        ASSERTER_WITH_RET(retDomain == NO_ERROR, retDomain);
+        const DualHorizon* dual = nullptr;
+        if (!mSpacing.empty()) {
+            int retDual = mDual.init(mSpacing, {mConfig.horizon, mConfig.youngModulus, mThick, mVol,
+                &Dimension<Dim>::bondConstant, &Dimension<Dim>::volume});
+            ASSERTER_WITH_RET(retDual == NO_ERROR, retDual);
+            dual = &mDual;
+        }
+        int retState = mState.init(mPoints.size());
+        ASSERTER_WITH_RET(retState == NO_ERROR, retState);
+        VecField coord = mState.coord();
+        for (int i = 0; i < mTotLocal; ++i) {
+            coord.set(i, mPoints[i]);
+        }
+
+        // 2. 邻域搜索：建立每个粒子的邻居列表（cell list，O(N)），并转为键表
+        // 键表与键几何可存放在内存映射文件中（超过内存容量的问题）
+        int retStorage = mBonds.setStorage(mConfig.bondStorage);
+        ASSERTER_WITH_RET(retStorage == NO_ERROR, retStorage);
+        mGeometry.setStorage(mConfig.bondStorage);
+        if (mBonds.isMapped() && isRoot()) {
+            cout << "Bond storage: mapped files in " << mConfig.bondStorage << endl;
+        }
+        int retBonds = buildBonds();
+        ASSERTER_WITH_RET(retBonds == NO_ERROR, retBonds);
+        if (isRoot()) {
+            cout << "Bonds" << (mTransport->numRanks() > 1 ? " (rank 0): " : ": ") << mBonds.numBonds()
+                 << " (" << mBonds.sizeByByte() / 1024 << " KB)" << endl;
+        }
+
+        // 3-4. 计算表面修正因子（各方向在一遍键表扫描中并行计算），幽灵粒子的因子由所有者发来
+        vector<vector<double>> fncst;
+        int retCorrection = computeSurfaceCorrection(fncst);
+        ASSERTER_WITH_RET(retCorrection == NO_ERROR, retCorrection);
+        double* factors[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            factors[d] = fncst[d].data();
+        }
+        int retFactors = exchangeGhosts(factors);
+        ASSERTER_WITH_RET(retFactors == NO_ERROR, retFactors);
+
+        // 5. 预计算键几何不变量（参考键长、体积修正、表面修正后的键系数）
+        int retGeometry = Dimension<Dim>::buildGeometry(mGeometry, mBonds, mPoints, fncst, {mDelta, mDx, mBc, mVol, dual});
+        ASSERTER_WITH_RET(retGeometry == NO_ERROR, retGeometry);
+
+        // 6. 初始化质量向量（用于动态松弛算法），变分辨率时按各粒子的作用域计算，并按对偶作用域的键刚度放大
+        const double dt = mConfig.dt;
+        const double mass = 0.25 * dt * dt * Dimension<Dim>::horizonMeasure(mDelta, mThick) * mBc / mDx;
+        vector<double> massScale;
+        if (dual != nullptr) {
+            int retScale = mDual.massScale(mBonds, mGeometry.idist(), mTotLocal, massScale);
+            ASSERTER_WITH_RET(retScale == NO_ERROR, retScale);
+        }
+        VecField massvec = mState.mass();
+        for (int i = 0; i < mTotLocal; ++i) {
+            double m = mass;
+            if (dual != nullptr) {
+                m = 0.25 * dt * dt * Dimension<Dim>::horizonMeasure(mDual.horizons()[i], mThick) * mDual.bondConstant(i)
+                    / mDual.spacing(i) * massScale[i];
+            }
+            for (int d = 0; d < Dim; ++d) {
+                massvec.component(d)[i] = m;
+            }
+        }
+
+        // 断裂判断区域限制（|y| <= length/4）
+        mBreakable.resize(mTotLocal);
+        for (int i = 0; i < mTotLocal; ++i) {
+            mBreakable[i] = abs(coord.y[i]) <= mConfig.length/4.0 ? 1 : 0;
+        }
+
+        return buildKernels();
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::generateParticles()
+    {
+        const double length = mConfig.length, width = mConfig.width, dx = mDx, radius = mConfig.holeRadius;
+        const double thickness = mConfig.ndivz * dx;
+
+        mPoints.clear();
+        mPoints.reserve(mConfig.maxParticles());
+
+        // 各区域按 x、y、z 的顺序编号（x 最快），三维时 z 方向覆盖整个厚度
+        double first[Dim], step[Dim];
+        int count[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            step[d] = dx;
+        }
+        first[0] = -length/2 + dx/2;
+        count[0] = mConfig.ndivx;
+        if (Dim == 3) {
+            first[Dim - 1] = -thickness/2 + dx/2;
+            count[Dim - 1] = mConfig.ndivz;
+        }
+
+        // 内部区域（排除贯穿厚度的中心孔）
+        first[1] = -width/2 + dx/2;
+        count[1] = mConfig.ndivy;
+        generateLattice<Dim>(first, step, count, [&](const Point& p) {
+            return sqrt(p.x*p.x + p.y*p.y) > radius;
+        }, mPoints);
+        mTotInt = static_cast<int>(mPoints.size()); // 内部粒子数
+
+        // 底部边界粒子（y方向外侧，向下扩展）
+        auto all = [](const Point&) { return true; };
+        first[1] = -width/2 - dx/2;
+        step[1] = -dx;
+        count[1] = mConfig.nband;
+        generateLattice<Dim>(first, step, count, all, mPoints);
+        mTotBottom = static_cast<int>(mPoints.size()); // 底部边界后总粒子数
+
+        // 顶部边界粒子（y方向外侧，向上扩展）
+        first[1] = width/2 + dx/2;
+        step[1] = dx;
+        generateLattice<Dim>(first, step, count, all, mPoints);
+        mTotTop = static_cast<int>(mPoints.size()); // 顶部边界后总粒子数
+        mPoints.shrink_to_fit();
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::generateGradedParticles()
+    {
+        const double length = mConfig.length, width = mConfig.width, dx = mDx, radius = mConfig.holeRadius;
+        const int levels = mConfig.refineLevels;
+        const double coarse = dx * (1 << levels);
+        const double thickness = mConfig.ndivz * dx;
+
+        mPoints.clear();
+        mSpacing.clear();
+
+        // 边长 coarse 的单元按 x、y、z 的顺序编号（x 最快），单元中心到孔边的距离 d 决定层级
+        // k = min(levels, floor(log2(1 + d / refineWidth)))，单元内为间距 dx * 2^k 的点阵，粒子体积之和等于单元体积
+        double first[Dim], step[Dim];
+        int count[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            step[d] = coarse;
+        }
+        first[0] = -length/2 + coarse/2;
+        count[0] = mConfig.ndivx >> levels;
+        first[1] = -width/2 + coarse/2;
+        count[1] = mConfig.ndivy >> levels;
+        if (Dim == 3) {
+            first[Dim - 1] = -thickness/2 + coarse/2;
+            count[Dim - 1] = mConfig.ndivz >> levels;
+        }
+        vector<Point> cells;
+        auto all = [](const Point&) { return true; };
+        generateLattice<Dim>(first, step, count, all, cells);
+        vector<int> cellLevels(cells.size());
+        for (size_t c = 0; c < cells.size(); ++c) {
+            double d = max(sqrt(cells[c].x*cells[c].x + cells[c].y*cells[c].y) - radius, 0.0);
+            cellLevels[c] = min(levels, static_cast<int>(floor(log2(1.0 + d / mConfig.refineWidth))));
+        }
+
+        // 单元 c 的点阵; y 方向从 y0 开始按 dy 的符号排列 rows 行 (rows 为 0 时即单元本身)
+        auto fill = [&](size_t c, double y0, double dy, int rows, bool (*keep)(const Point&, double)) {
+            const double h = dx * (1 << cellLevels[c]);
+            double cellFirst[Dim], cellStep[Dim];
+            int cellCount[Dim];
+            for (int d = 0; d < Dim; ++d) {
+                cellFirst[d] = cells[c][d] - coarse/2 + h/2;
+                cellStep[d] = h;
+                cellCount[d] = 1 << (levels - cellLevels[c]);
+            }
+            if (rows > 0) {
+                cellFirst[1] = y0 + (dy > 0 ? h/2 : -h/2);
+                cellStep[1] = dy > 0 ? h : -h;
+                cellCount[1] = rows;
+            }
+            generateLattice<Dim>(cellFirst, cellStep, cellCount, [&](const Point& p) { return keep(p, radius); }, mPoints);
+            mSpacing.resize(mPoints.size(), h);
+        };
+
+        // 内部区域（排除贯穿厚度的中心孔）
+        for (size_t c = 0; c < cells.size(); ++c) {
+            fill(c, 0.0, 0.0, 0, [](const Point& p, double r) { return sqrt(p.x*p.x + p.y*p.y) > r; });
+        }
+        mTotInt = static_cast<int>(mPoints.size());
+
+        // 底部与顶部边界粒子: 紧邻的单元向外扩展 nband 层，间距与该单元相同
+        auto band = [](const Point&, double) { return true; };
+        const size_t ncx = count[0], ncy = count[1];
+        for (size_t c = 0; c < cells.size(); ++c) {
+            if ((c / ncx) % ncy == 0) {
+                fill(c, -width/2, -1.0, mConfig.nband, band);
+            }
+        }
+        mTotBottom = static_cast<int>(mPoints.size());
+        for (size_t c = 0; c < cells.size(); ++c) {
+            if ((c / ncx) % ncy == ncy - 1) {
+                fill(c, width/2, 1.0, mConfig.nband, band);
+            }
+        }
+        mTotTop = static_cast<int>(mPoints.size());
+        mPoints.shrink_to_fit();
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::reorderParticles()
+    {
+        // 可选：各区域内部按 Morton 序重编号，提高邻居访问的缓存局部性
+        // order[k] 为新编号 k 对应的原编号，mRank 为其逆排列（按原顺序输出结果）
+        vector<int> order(mTotTop);
+        iota(order.begin(), order.end(), 0);
+        if (mConfig.reorder) {
+            int retOrder = sortByMorton(mPoints, 0, mTotInt, order);
+            ASSERTER_WITH_RET(retOrder == NO_ERROR, retOrder);
+            retOrder = sortByMorton(mPoints, mTotInt, mTotBottom, order);
+            ASSERTER_WITH_RET(retOrder == NO_ERROR, retOrder);
+            retOrder = sortByMorton(mPoints, mTotBottom, mTotTop, order);
+            ASSERTER_WITH_RET(retOrder == NO_ERROR, retOrder);
+            ParticleOrder::apply(order, mPoints);
+            cout << "Particle order: morton" << endl;
+        }
+        ParticleOrder::inverse(order, mRank);
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::localizeParticles()
+    {
+        // 幽灵层宽度取最大的作用域半径
+        const int ranks = mTransport->numRanks();
+        const double reach = mSpacing.empty() ? mDelta : mConfig.horizon * *max_element(mSpacing.begin(), mSpacing.end());
+        int retDomain = mDomain.init(mPoints, {mTotInt, mTotBottom, mTotTop}, ranks, mTransport->rank(), reach);
+        ASSERTER_WITH_RET(retDomain == NO_ERROR, retDomain);
+        mGlobalInt = mTotInt;
+        if (ranks > 1) {
+            const vector<int>& ids = mDomain.globalIds();
+            vector<Point> local(ids.size());
+            vector<double> spacing(mSpacing.empty() ? 0 : ids.size());
+            for (size_t k = 0; k < ids.size(); ++k) {
+                local[k] = mPoints[ids[k]];
+            }
+            for (size_t k = 0; k < spacing.size(); ++k) {
+                spacing[k] = mSpacing[ids[k]];
+            }
+            mPoints.swap(local);
+            mSpacing.swap(spacing);
+            if (isRoot()) {
+                cout << "Ranks: " << ranks << " (rank 0: " << mDomain.local().numInt << " interior, "
+                     << mDomain.numGhosts() << " ghost particles)" << endl;
+            }
+        }
+        mTotInt = mDomain.local().numInt;
+        mTotBottom = mDomain.local().numBottom;
+        mTotTop = mDomain.local().numTop;
+        mTotLocal = mDomain.numLocal();
+
+        // 幽灵层交换每个粒子 Dim 个值; 汇总时每个内部粒子发送全局编号与 2 * Dim + 1 列结果
+        vector<size_t> haloCounts(ranks), gatherCounts(ranks, 0);
+        for (int p = 0; p < ranks; ++p) {
+            haloCounts[p] = mDomain.sendList(p).size() * Dim;
+        }
+        if (!isRoot()) {
+            gatherCounts[0] = static_cast<size_t>(mTotInt) * (2 * Dim + 2);
+        }
+        int retHalo = mTransport->connect(haloCounts, mHaloChannel);
+        ASSERTER_WITH_RET(retHalo == NO_ERROR, retHalo);
+        int retGather = mTransport->connect(gatherCounts, mGatherChannel);
+        ASSERTER_WITH_RET(retGather == NO_ERROR, retGather);
+        mSendBuffers.assign(ranks, vector<double>());
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::buildBonds()
+    {
+        // 幽灵粒子不建键，变分辨率时按各粒子的作用域搜索
+        vector<int> numfam, pointfam, nodefam;
+        int retSearch = mSpacing.empty() ? NeighborSearch::buildByCellList(mPoints, mDelta, numfam, pointfam, nodefam)
+            : NeighborSearch::buildByCellList(mPoints, mDual.horizons(), numfam, pointfam, nodefam);
+        ASSERTER_WITH_RET(retSearch == NO_ERROR, retSearch);
+        mDomain.localizeFamilies(numfam, pointfam, nodefam);
+
+        return mBonds.init(numfam, std::move(nodefam));
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::computeSurfaceCorrection(vector<vector<double>>& fncst)
+    {
+        // 每个方向一次均匀拉伸，应变 0.001
+        const double strain = 1.0e-3;
+        SurfaceCorrection::Params params = {mDelta, mDx, mBc, mVol, strain,
+            Dimension<Dim>::strainEnergyDensity(mConfig.youngModulus, strain), mDual.empty() ? nullptr : &mDual};
+        VecField coord = mState.coord();
+        vector<const double*> coords;
+        for (int d = 0; d < Dim; ++d) {
+            coords.push_back(coord.component(d));
+        }
+
+        framework::Flow& flow = framework::Flow::get();
+        flow.deinit();
+        int retFlow = flow.init(mConfig.threads, 1);
+        ASSERTER_WITH_RET(retFlow == NO_ERROR, retFlow);
+        int ret = SurfaceCorrection::compute(mBonds, coords, mTotLocal, params, tileOf(mTotLocal, mConfig.threads), fncst);
+        flow.deinit();
+        return ret;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::buildKernels()
+    {
+        const ForceEngine engine = mConfig.engine;
+
+        // 按 CPU 支持的指令集选择键力核函数
+        mSimd = BondKernel::detect();
+        mKernel = Dimension<Dim>::template kernel<P>(mSimd);
+        if (isRoot()) {
+            cout << "Bond kernel: " << Dimension<Dim>::kernelName(mSimd) << " (" << P::name() << ")" << endl;
+        }
+
+        // 半键模式：每对粒子只计算一次键力，再按粒子带符号汇总
+        if (engine == FORCE_ENGINE_HALF_BOND) {
+            int retHalfBond = mHalfBondKernel.init(mBonds, mTotInt);
+            ASSERTER_WITH_RET(retHalfBond == NO_ERROR, retHalfBond);
+            cout << "Half-bond pairs: " << mHalfBondKernel.numPairs() << " (" << mHalfBondKernel.sizeByByte() / 1024 << " KB)" << endl;
+        }
+
+        // 点阵模板：规则粒子按固定偏移读取网格上的位移，孔边与边界附近的粒子逐键计算
+        if (engine == FORCE_ENGINE_STENCIL) {
+            int retStencil = initStencil(mStencil, mPoints, mDx, mDelta, mBonds, mTotInt);
+            ASSERTER_WITH_RET(retStencil == NO_ERROR, retStencil);
+            cout << "Stencil: " << mStencil.stencilSize() << " neighbors, " << mStencil.numRegular() << "/" << mTotInt << " regular particles" << endl;
+        }
+
+        // 损伤只在断键时由核函数增量更新
+        int retDamage = mDamage.init(mBonds, mGeometry.fac(), mVol, mTotInt, mState.damage());
+        ASSERTER_WITH_RET(retDamage == NO_ERROR, retDamage);
+
+        VecField disp = mState.disp();
+        VecField force = mState.force();
+        mKernelArgs.offsets = mBonds.offsets();
+        mKernelArgs.ends = mBonds.liveEnds();
+        mKernelArgs.neighbors = mBonds.neighbors();
+        mKernelArgs.alive = mBonds.aliveMask();
+        mKernelArgs.rx = mGeometry.rx();
+        mKernelArgs.ry = mGeometry.ry();
+        mKernelArgs.rz = mGeometry.rz();
+        mKernelArgs.idist = mGeometry.idist();
+        mKernelArgs.fac = mGeometry.fac();
+        mKernelArgs.coef = mGeometry.coef();
+        mKernelArgs.dispx = disp.x;
+        mKernelArgs.dispy = disp.y;
+        mKernelArgs.dispz = Dim == 3 ? disp.component(2) : nullptr;
+        mKernelArgs.breakable = mBreakable.data();
+        mKernelArgs.scr0 = mConfig.criticalStretch;
+        mKernelArgs.vol = mVol;
+        mKernelArgs.forcex = force.x;
+        mKernelArgs.forcey = force.y;
+        mKernelArgs.forcez = Dim == 3 ? force.component(2) : nullptr;
+        mKernelArgs.brokenWeight = mDamage.brokenWeight();
+        mKernelArgs.refWeight = mDamage.refWeight();
+        mKernelArgs.damage = mState.damage();
+        mKernelArgs.numBroken = mDamage.brokenCounter();
+
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::printTraffic() const
+    {
+        if (!isRoot()) {
+            return;
+        }
+        const ForceEngine engine = mConfig.engine;
+        const size_t numBonds = mBonds.begin(mTotInt);
+        size_t regularBonds = engine == FORCE_ENGINE_STENCIL ? mStencil.numRegular() * mStencil.stencilSize() : 0;
+        StepTraffic fused = stepTraffic(engine, true, mTotInt, mTotTop, numBonds, mHalfBondKernel.numPairs(), regularBonds,
+            sizeof(Real), Dim);
+        StepTraffic unfused = stepTraffic(engine, false, mTotInt, mTotTop, numBonds, mHalfBondKernel.numPairs(), regularBonds,
+            sizeof(Real), Dim);
+        cout << "Memory traffic per step: " << fused.numPasses() << " passes, " << fused.bytesPerBond(numBonds) << " B/bond"
+             << " (unfused: " << unfused.numPasses() << " passes, " << unfused.bytesPerBond(numBonds) << " B/bond)" << endl;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::exchangeGhosts(double* const* fields)
+    {
+        const int ranks = mTransport->numRanks();
+        if (ranks == 1) {
+            return NO_ERROR;
+        }
+        for (int p = 0; p < ranks; ++p) {
+            const vector<int>& ids = mDomain.sendList(p);
+            vector<double>& buffer = mSendBuffers[p];
+            buffer.resize(ids.size() * Dim);
+            for (size_t k = 0; k < ids.size(); ++k) {
+                for (int d = 0; d < Dim; ++d) {
+                    buffer[k * Dim + d] = fields[d][ids[k]];
+                }
+            }
+        }
+        int retExchange = mTransport->exchange(mHaloChannel, mSendBuffers, mRecvBuffers);
+        ASSERTER_WITH_RET(retExchange == NO_ERROR, retExchange);
+        for (int p = 0; p < ranks; ++p) {
+            const vector<int>& ids = mDomain.recvList(p);
+            const vector<double>& buffer = mRecvBuffers[p];
+            ASSERTER_WITH_RET(buffer.size() == ids.size() * Dim, ERROR_INVALID_PARAMETER);
+            for (size_t k = 0; k < ids.size(); ++k) {
+                for (int d = 0; d < Dim; ++d) {
+                    fields[d][ids[k]] = buffer[k * Dim + d];
+                }
+            }
+        }
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::gatherInterior(vector<double>& table)
+    {
+        const int ranks = mTransport->numRanks();
+        const size_t cols = 2 * Dim + 1;
+        VecField coord = mState.coord();
+        VecField disp = mState.disp();
+        const double* dmg = mState.damage();
+        auto fill = [&](double* row, int i) {
+            for (int d = 0; d < Dim; ++d) {
+                row[d] = coord.component(d)[i];
+                row[Dim + d] = disp.component(d)[i];
+            }
+            row[2 * Dim] = dmg[i];
+        };
+
+        const vector<int>& ids = mDomain.globalIds();
+        table.clear();
+        if (isRoot()) {
+            table.resize(static_cast<size_t>(mGlobalInt) * cols);
+            for (int i = 0; i < mTotInt; ++i) {
+                fill(&table[ids[i] * cols], i);
+            }
+        }
+        if (ranks == 1) {
+            return NO_ERROR;
+        }
+
+        for (int p = 0; p < ranks; ++p) {
+            mSendBuffers[p].clear();
+        }
+        if (!isRoot()) {
+            vector<double>& buffer = mSendBuffers[0];
+            buffer.resize(static_cast<size_t>(mTotInt) * (cols + 1));
+            for (int i = 0; i < mTotInt; ++i) {
+                buffer[i * (cols + 1)] = ids[i];
+                fill(&buffer[i * (cols + 1) + 1], i);
+            }
+        }
+        int retExchange = mTransport->exchange(mGatherChannel, mSendBuffers, mRecvBuffers);
+        ASSERTER_WITH_RET(retExchange == NO_ERROR, retExchange);
+        if (isRoot()) {
+            for (int p = 1; p < ranks; ++p) {
+                const vector<double>& buffer = mRecvBuffers[p];
+                for (size_t k = 0; k + cols < buffer.size(); k += cols + 1) {
+                    copy(buffer.begin() + k + 1, buffer.begin() + k + 1 + cols, table.begin() + static_cast<size_t>(buffer[k]) * cols);
+                }
+            }
+        }
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    bool PdSolver<P, Dim, Transport>::isOutputStep(int step) const
+    {
+        return find(mConfig.outputSteps.begin(), mConfig.outputSteps.end(), step) != mConfig.outputSteps.end();
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::writeOutput(int step)
+    {
+        vector<double> table;
+        int retGather = gatherInterior(table);
+        ASSERTER_WITH_RET(retGather == NO_ERROR, retGather);
+        if (!isRoot()) {
+            return NO_ERROR;
+        }
+        const string filename = string(Dim == 3 ? "coord_disp_pd3d_" : "coord_disp_pd_") + to_string(step) + ".txt";
+        const size_t cols = 2 * Dim + 1;
+
+        ofstream outFile(filename);
+        if (outFile.is_open()) {
+            outFile.precision(5);
+            outFile << scientific;
+            for (int o = 0; o < mGlobalInt; ++o) {
+                const double* row = &table[mRank[o] * cols];
+                for (size_t c = 0; c + 1 < cols; ++c) {
+                    outFile << row[c] << " ";
+                }
+                outFile << row[cols - 1] << endl;
+            }
+            outFile.close();
+            cout << "Output saved to " << filename << endl;
+        } else {
+            cerr << "Error opening file: " << filename << endl;
+        }
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::run(HoleResult* result)
+    {
+        ASSERTER_WITH_RET(mKernel != nullptr, ERROR_INVALID_PARAMETER);
+
+        // 断键压缩：断键移到各粒子键区间的末尾，不再进入键循环（半键模式不支持, 由 SimConfig::validate 拒绝）
+        const CompactionPolicy& compaction = mConfig.compaction;
+        mCompactEnabled = compaction.interval > 0 || compaction.threshold > 0.0;
+        mLiveBonds = mBonds.begin(mTotInt) - mDamage.numBroken(); // 参与计算的键数（内部粒子）
+        mBrokenAtCompaction = mDamage.numBroken();
+        mNumCompactions = 0;
+
+        // 7. 初始化线程池（每次运行可使用不同线程数）
+        framework::Flow& flow = framework::Flow::get();
+        flow.deinit();
+        int retFlow = flow.init(mConfig.threads, 1);
+        ASSERTER_WITH_RET(retFlow == NO_ERROR, retFlow);
+        if (isRoot()) {
+            cout << "Threads: " << mConfig.threads << endl;
+        }
+
+        printTraffic();
+
+        // 8. 求解：伪时间步松弛或逐加载步的准静态平衡
+        perf::Timer timer;
+        int iterations = 0;
+        int retSolve = NO_ERROR;
+        if (mConfig.method == SOLVER_PCG) {
+            retSolve = runQuasiStatic(iterations);
+        } else if (mConfig.method == SOLVER_DYNAMIC) {
+            retSolve = runDynamic(iterations);
+        } else if (mConfig.integrator == INTEGRATOR_FIRE) {
+            BasicFireIntegrator<Dim> fire;
+            retSolve = runRelaxation(fire, iterations);
+        } else {
+            BasicAdrIntegrator<Dim> adr;
+            retSolve = runRelaxation(adr, iterations);
+        }
+        ASSERTER_WITH_RET(retSolve == NO_ERROR, retSolve);
+        float elapsed = timer.count();
+
+        flow.deinit();
+
+        if (mCompactEnabled) {
+            cout << "Bond compactions: " << mNumCompactions << ", broken bonds: " << mDamage.numBroken()
+                 << ", live bonds: " << mLiveBonds << "/" << mBonds.begin(mTotInt) << endl;
+        }
+
+        // 每条键只属于一个 rank, 断键数按 rank 求和
+        double numBroken = static_cast<double>(mDamage.numBroken());
+        int retBroken = mTransport->allReduce(&numBroken, 1);
+        ASSERTER_WITH_RET(retBroken == NO_ERROR, retBroken);
+
+        // 汇总须由各 rank 共同参与
+        vector<double> table;
+        if (result != nullptr || mTransport->numRanks() > 1) {
+            int retGather = gatherInterior(table);
+            ASSERTER_WITH_RET(retGather == NO_ERROR, retGather);
+        }
+        if (result != nullptr && isRoot()) {
+            const size_t cols = 2 * Dim + 1;
+            const size_t nz = Dim == 3 ? mGlobalInt : 0;
+            result->dispx.resize(mGlobalInt);
+            result->dispy.resize(mGlobalInt);
+            result->dispz.resize(nz);
+            result->damage.resize(mGlobalInt);
+            for (int o = 0; o < mGlobalInt; ++o) {
+                const double* row = &table[mRank[o] * cols];
+                result->dispx[o] = row[Dim];
+                result->dispy[o] = row[Dim + 1];
+                if (nz > 0) {
+                    result->dispz[o] = row[2 * Dim - 1];
+                }
+                result->damage[o] = row[2 * Dim];
+            }
+            result->numBroken = static_cast<size_t>(numBroken);
+            result->iterations = iterations;
+        }
+
+        if (isRoot()) {
+            cout << "Solve time: " << elapsed << " ms" << endl;
+            cout << "Simulation completed!" << endl;
+        }
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    double PdSolver<P, Dim, Transport>::loadTime(int increment, int numIncrements) const
+    {
+        return static_cast<double>(mConfig.steps) * increment / numIncrements * mConfig.dt;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::applyBoundary(size_t i, double ctime)
+    {
+        VecField vel = mState.vel();
+        VecField disp = mState.disp();
+        vel.y[i] = (i < static_cast<size_t>(mTotBottom)) ? -mConfig.velocity : mConfig.velocity;
+        disp.y[i] = vel.y[i] * ctime;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::compactBonds(int step)
+    {
+        // 每 interval 步，或新断键比例超过 threshold
+        const CompactionPolicy& compaction = mConfig.compaction;
+        size_t newlyBroken = mDamage.numBroken() - mBrokenAtCompaction;
+        if (!mCompactEnabled || newlyBroken == 0
+            || !((compaction.interval > 0 && step % compaction.interval == 0)
+                || (compaction.threshold > 0.0 && newlyBroken > compaction.threshold * mLiveBonds))) {
+            return;
+        }
+
+        vector<Real*> bondFields = mGeometry.fields();
+        XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(mTotInt, tileOf(mTotInt, mConfig.threads))
+            mBonds.compact(static_cast<int>(_i), static_cast<int>(_i + _ti), bondFields);
+        XTHREAD_PARALLELIZE_END
+        if (mConfig.engine == FORCE_ENGINE_STENCIL) {
+            mStencil.refresh(mBonds);
+        }
+        mLiveBonds -= newlyBroken;
+        mBrokenAtCompaction += newlyBroken;
+        ++mNumCompactions;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::prefetchBonds(int begin, int end) const
+    {
+        end = min(end, mTotInt);
+        if (!mBonds.isMapped() || begin >= end) {
+            return;
+        }
+        mBonds.prefetch(begin, end);
+        mGeometry.prefetch(mBonds.begin(begin), mBonds.begin(end));
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::recomputeForces(const vector<pair<int, int>>& runs)
+    {
+        XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(runs.size(), tileOf(runs.size(), mConfig.threads))
+            for (size_t r = _i; r < _i + _ti; ++r) {
+                computeForces(mConfig.engine, mKernel, mHalfBondKernel, mStencil, mKernelArgs, runs[r].first, runs[r].second);
+            }
+        XTHREAD_PARALLELIZE_END
+    }
+
+    template<typename P, int Dim, typename Transport>
+    void PdSolver<P, Dim, Transport>::expandRegion(const vector<int>& particles, vector<int>& region) const
+    {
+        region = particles;
+        for (int i : particles) {
+            for (size_t b = mBonds.begin(i); b < mBonds.end(i); ++b) {
+                int j = mBonds.neighbor(b);
+                if (j < mTotInt) {
+                    region.push_back(j);
+                }
+            }
+        }
+        sort(region.begin(), region.end());
+        region.erase(unique(region.begin(), region.end()), region.end());
+    }
+
+    template<typename P, int Dim, typename Transport>
+    template<typename Integrator>
+    int PdSolver<P, Dim, Transport>::settleBreaks(Integrator& integrator, size_t& numParticles)
+    {
+        VecField disp = mState.disp();
+
+        // 有新断键的粒子立即以新的键族重算键力（同一位移下不会再有新的断键）
+        vector<int> active, changed;
+        vector<pair<int, int>> runs;
+        mDamage.collectChanged(changed);
+        toRuns(changed, runs);
+        recomputeForces(runs);
+        expandRegion(changed, active);
+        toRuns(active, runs);
+
+        // 局部松弛：只推进键族变化的粒子并重算其键力，由此产生的新断键粒子加入，直到没有新断键或达到 breakSubsteps
+        int substeps = 0;
+        while (substeps < mConfig.breakSubsteps) {
+            ++substeps;
+            const size_t brokenBefore = mDamage.numBroken();
+            XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(runs.size(), tileOf(runs.size(), mConfig.threads))
+                for (size_t r = _i; r < _i + _ti; ++r) {
+                    integrator.update(runs[r].first, runs[r].second);
+                    if (mConfig.engine == FORCE_ENGINE_STENCIL) {
+                        mStencil.scatter(disp.x, disp.y, runs[r].first, runs[r].second);
+                    }
+                }
+            XTHREAD_PARALLELIZE_END
+            recomputeForces(runs);
+            if (mDamage.numBroken() == brokenBefore) {
+                break;
+            }
+
+            // 新断键的粒子以新的键族重算键力，其作用域加入局部松弛区域
+            changed.clear();
+            mDamage.collectChanged(changed);
+            vector<pair<int, int>> changedRuns;
+            toRuns(changed, changedRuns);
+            recomputeForces(changedRuns);
+
+            vector<int> region, merged;
+            expandRegion(changed, region);
+            merged.reserve(active.size() + region.size());
+            set_union(active.begin(), active.end(), region.begin(), region.end(), back_inserter(merged));
+            active.swap(merged);
+            toRuns(active, runs);
+        }
+
+        numParticles = active.size();
+        return substeps;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    template<typename Integrator>
+    int PdSolver<P, Dim, Transport>::runRelaxation(Integrator& integrator, int& iterations)
+    {
+        const ForceEngine engine = mConfig.engine;
+        const size_t threads = mConfig.threads;
+        const int totint = mTotInt, tottop = mTotTop;
+
+        double* disp[Dim];          // 位移
+        double* pforce[Dim];        // 总作用力
+        double* velhalfold[Dim];    // 上一步位移更新所用的速度
+        for (int d = 0; d < Dim; ++d) {
+            disp[d] = mState.disp().component(d);
+            pforce[d] = mState.force().component(d);
+            velhalfold[d] = mState.velHalfOld().component(d);
+        }
+
+        integrator.init(mState, mConfig.dt);
+        if (isRoot()) {
+            cout << "Relaxation: " << Integrator::name() << endl;
+        }
+
+        const size_t tileInt = tileOf(totint, threads);
+        // 第一遍扫描按固定分块，求和结果与线程数无关，各 rank 的部分和再按 rank 顺序求和
+        // 0 为 ||u||^2，1 为上一步位移增量的平方和，2 为不平衡力的平方和，之后为积分器的部分和
+        const int NUM_SUMS = 3 + Integrator::NUM_SUMS;
+        framework::DeterministicReduce<NUM_SUMS> stepReduce;
+
+        // 加载步：边界位移按加载步等分最终位移（velocity * steps * dt），未设置加载步时每步推进一次
+        const int numIncrements = mConfig.convergence.loadSteps > 0 ? mConfig.convergence.loadSteps : mConfig.steps;
+        const int incrementBudget = mConfig.steps / numIncrements; // 每个加载步的最大迭代次数
+        int increment = 1;
+
+        ResidualMonitor monitor;
+        monitor.init(mConfig.convergence);
+        monitor.beginIncrement();
+
+        // 断键子步
+        const bool breakSubsteps = mConfig.breakSubsteps > 0;
+        size_t brokenSettled = mDamage.numBroken();
+        size_t totalSubsteps = 0;
+
+        // 边界条件：底部固定速度向下，顶部固定速度向上
+        for (size_t i = totint; i < static_cast<size_t>(tottop); ++i) {
+            applyBoundary(i, loadTime(increment, numIncrements));
+        }
+        if (engine == FORCE_ENGINE_STENCIL) {
+            mStencil.scatter(disp[0], disp[1], 0, tottop);
+        }
+        int retHalo = exchangeGhosts(disp);
+        ASSERTER_WITH_RET(retHalo == NO_ERROR, retHalo);
+
+        // 8. 时间积分主循环
+        // 每步两遍扫描：(1) 力、损伤与积分器部分和；(2) 积分更新，并施加下一步的边界条件，之后交换幽灵层的位移
+        for (int tt = 1; tt <= mConfig.steps; ++tt) {
+            if (isRoot()) {
+                cout << "Time step: " << tt << endl;
+            }
+
+            // 半键模式需先完成所有粒子对的键力
+            if (engine == FORCE_ENGINE_HALF_BOND) {
+                XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(totint, tileInt)
+                    computePairs(mHalfBondKernel, mKernelArgs, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                XTHREAD_PARALLELIZE_END
+            }
+
+            // --------------------- 力计算、损伤评估与积分器求和 ---------------------
+            // 仅内部粒子参与力与断裂计算，核函数覆盖写入 pforce，断键时更新损伤；同一块内紧接着累加残差与积分器部分和
+            const double dt = integrator.timeStep();
+            auto accumulate = [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[NUM_SUMS]) {
+                for (size_t i = _i; i < _i + _ti; ++i) {
+                    double dispNorm2 = disp[0][i] * disp[0][i];
+                    double velNorm2 = velhalfold[0][i] * velhalfold[0][i];
+                    double forceNorm2 = pforce[0][i] * pforce[0][i];
+                    for (int d = 1; d < Dim; ++d) {
+                        dispNorm2 += disp[d][i] * disp[d][i];
+                        velNorm2 += velhalfold[d][i] * velhalfold[d][i];
+                        forceNorm2 += pforce[d][i] * pforce[d][i];
+                    }
+                    partial[0].add(dispNorm2);
+                    partial[1].add(velNorm2 * dt * dt);
+                    partial[2].add(forceNorm2);
+                }
+                integrator.accumulate(_i, _i + _ti, partial + 3);
+            };
+            double sums[NUM_SUMS];
+            int retReduce = stepReduce.run(totint, [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[NUM_SUMS]) {
+                int begin = static_cast<int>(_i), end = static_cast<int>(_i + _ti);
+                prefetchBonds(end, end + (end - begin));
+                computeForces(engine, mKernel, mHalfBondKernel, mStencil, mKernelArgs, begin, end);
+                accumulate(_i, _ti, partial);
+            }, sums);
+            ASSERTER_WITH_RET(retReduce == NO_ERROR, retReduce);
+            int retSums = mTransport->allReduce(sums, NUM_SUMS);
+            ASSERTER_WITH_RET(retSums == NO_ERROR, retSums);
+            iterations = tt;
+
+            // --------------------- 断键子步：新断键在本步内生效并局部松弛 ---------------------
+            if (breakSubsteps && mDamage.numBroken() != brokenSettled) {
+                const size_t brokenBefore = brokenSettled;
+                size_t numParticles = 0;
+                int substeps = settleBreaks(integrator, numParticles);
+                brokenSettled = mDamage.numBroken();
+                cout << "Bonds broken: " << brokenSettled - brokenBefore << ", settled in " << substeps
+                     << " substeps over " << numParticles << " particles" << endl;
+                totalSubsteps += substeps;
+
+                // 局部重算后的力与位移重新求和
+                retReduce = stepReduce.run(totint, accumulate, sums);
+                ASSERTER_WITH_RET(retReduce == NO_ERROR, retReduce);
+            }
+
+            // --------------------- 残差与收敛判断 ---------------------
+            monitor.update(tt, sums[2], sums[1], sums[0], mDamage.numBroken());
+            bool converged = monitor.converged();
+            if (monitor.enabled()) {
+                cout << "Residual: force " << monitor.forceResidual() << ", disp " << monitor.dispResidual() << endl;
+            }
+            if (converged) {
+                cout << "Load step " << increment << "/" << numIncrements << " converged after "
+                     << monitor.incrementIterations() << " iterations" << endl;
+                if (increment == numIncrements) {
+                    int retOutput = writeOutput(tt);
+                    ASSERTER_WITH_RET(retOutput == NO_ERROR, retOutput);
+                    break;
+                }
+            }
+            if (increment < numIncrements && (converged || monitor.incrementIterations() >= incrementBudget)) {
+                ++increment;
+                monitor.beginIncrement();
+            }
+
+            integrator.prepare(tt, sums + 3, sums[0], sums[2]);
+
+            // --------------------- 速度和位移更新（显式积分）与下一步边界条件 ---------------------
+            const double nextTime = loadTime(increment, numIncrements);
+            XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(tottop, tileOf(tottop, threads))
+                size_t interiorEnd = min(_i + _ti, static_cast<size_t>(totint));
+                if (_i < interiorEnd) {
+                    integrator.update(_i, interiorEnd);
+                }
+                for (size_t i = max(_i, static_cast<size_t>(totint)); i < _i + _ti; ++i) {
+                    applyBoundary(i, nextTime);
+                }
+                if (engine == FORCE_ENGINE_STENCIL) {
+                    mStencil.scatter(disp[0], disp[1], static_cast<int>(_i), static_cast<int>(_i + _ti));
+                }
+            XTHREAD_PARALLELIZE_END
+            retHalo = exchangeGhosts(disp);
+            ASSERTER_WITH_RET(retHalo == NO_ERROR, retHalo);
+
+            // --------------------- 断键压缩 ---------------------
+            compactBonds(tt);
+
+            // --------------------- 结果输出（特定时间步） ---------------------
+            if (isOutputStep(tt)) {
+                int retOutput = writeOutput(tt);
+                ASSERTER_WITH_RET(retOutput == NO_ERROR, retOutput);
+            }
+        }
+
+        if (breakSubsteps) {
+            cout << "Break substeps: " << totalSubsteps << endl;
+        }
+        if (isRoot()) {
+            cout << "Iterations: " << iterations << " (" << Integrator::name() << "), load steps: " << increment << "/" << numIncrements << endl;
+        }
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::runDynamic(int& iterations)
+    {
+        // 只积分 x、y 分量（三维与区域分解由 SimConfig::validate 拒绝）
+        const ForceEngine engine = mConfig.engine;
+        const size_t threads = mConfig.threads;
+        const int totint = mTotInt, tottop = mTotTop;
+        const size_t tileInt = tileOf(totint, threads);
+        const double density = mConfig.density;
+
+        VecField disp = mState.disp();         // 位移
+        VecField vel = mState.vel();           // 速度（整步）
+        VecField pforce = mState.force();      // 作用力密度
+        VecField velhalf = mState.velHalfOld();// 半步速度
+
+        // --------------------- 稳定步长与子循环层级 ---------------------
+        vector<double> dtLocal(totint);
+        XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(totint, tileInt)
+            StableTimeStep::compute(mKernelArgs, density, dtLocal.data(), static_cast<int>(_i), static_cast<int>(_i + _ti));
+        XTHREAD_PARALLELIZE_END
+        const double dtCritical = totint > 0 ? *min_element(dtLocal.begin(), dtLocal.end()) : 0.0;
+        const double dt = mConfig.safetyFactor * dtCritical;
+        ASSERTER_WITH_INFO(dt > 0.0 && dt < numeric_limits<double>::infinity(), ERROR_INVALID_PARAMETER,
+            "no stable time step (critical %g)", dtCritical);
+
+        const int maxLevel = mConfig.subcycleLevels;
+        // 断键子步只在本步内重算键力（不做局部松弛，保持时间一致）
+        const bool breakSubsteps = mConfig.breakSubsteps > 0;
+        size_t brokenSettled = mDamage.numBroken();
+        vector<uint8_t> level(totint, 0);
+        StableTimeStep::levels(dtLocal.data(), dtCritical, maxLevel, level.data(), 0, totint);
+        cout << "Dynamic: dt " << dt << " (critical " << dtCritical << ", safety " << mConfig.safetyFactor << ")" << endl;
+        if (maxLevel > 0) {
+            vector<size_t> counts(maxLevel + 1, 0);
+            for (int i = 0; i < totint; ++i) {
+                ++counts[level[i]];
+            }
+            cout << "Subcycle levels:";
+            for (int l = 0; l <= maxLevel; ++l) {
+                cout << " " << l << ":" << counts[l];
+            }
+            cout << endl;
+        }
+
+        // 边界条件：底部固定速度向下，顶部固定速度向上
+        for (size_t i = totint; i < static_cast<size_t>(tottop); ++i) {
+            applyBoundary(i, 0.0);
+        }
+        if (engine == FORCE_ENGINE_STENCIL) {
+            mStencil.scatter(disp.x, disp.y, 0, tottop);
+        }
+
+        // 8. 时间积分主循环（速度 Verlet，加速度 = 力密度 / 密度）
+        // 每步两遍扫描：(1) 本步需更新的粒子的力与损伤；(2) 速度与位移更新，并施加下一步的边界条件
+        for (int tt = 1; tt <= mConfig.steps; ++tt) {
+            cout << "Time step: " << tt << endl;
+            const int n = tt - 1; // 当前状态所在的步
+
+            // --------------------- 力计算与损伤评估 ---------------------
+            if (maxLevel == 0) {
+                if (engine == FORCE_ENGINE_HALF_BOND) {
+                    XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(totint, tileInt)
+                        computePairs(mHalfBondKernel, mKernelArgs, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                    XTHREAD_PARALLELIZE_END
+                }
+                XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(totint, tileInt)
+                    prefetchBonds(static_cast<int>(_i + _ti), static_cast<int>(_i + 2 * _ti));
+                    computeForces(engine, mKernel, mHalfBondKernel, mStencil, mKernelArgs, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                XTHREAD_PARALLELIZE_END
+            } else {
+                // 只计算本步更新的粒子（层级 L 的粒子在 n 为 2^L 的倍数时更新），按连续区间调用核函数
+                XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(totint, tileInt)
+                    int end = static_cast<int>(_i + _ti);
+                    for (int i = static_cast<int>(_i); i < end;) {
+                        if (n % (1 << level[i]) != 0) {
+                            ++i;
+                            continue;
+                        }
+                        int j = i + 1;
+                        while (j < end && n % (1 << level[j]) == 0) {
+                            ++j;
+                        }
+                        computeForces(engine, mKernel, mHalfBondKernel, mStencil, mKernelArgs, i, j);
+                        i = j;
+                    }
+                XTHREAD_PARALLELIZE_END
+            }
+
+            // --------------------- 断键在本步内生效：有新断键的粒子以新的键族重算键力 ---------------------
+            if (breakSubsteps && mDamage.numBroken() != brokenSettled) {
+                vector<int> changed;
+                vector<pair<int, int>> runs;
+                mDamage.collectChanged(changed);
+                toRuns(changed, runs);
+                recomputeForces(runs);
+                brokenSettled = mDamage.numBroken();
+            }
+
+            // --------------------- 速度和位移更新与下一步边界条件 ---------------------
+            const double nextTime = tt * dt;
+            XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(tottop, tileOf(tottop, threads))
+                size_t interiorEnd = min(_i + _ti, static_cast<size_t>(totint));
+                for (size_t i = _i; i < interiorEnd; ++i) {
+                    // 速度只在粒子更新的步改变（步长 h = 2^L dt），位移每步推进，相邻的细层粒子看到连续的位移
+                    if (n % (1 << level[i]) == 0) {
+                        const double h = dt * (1 << level[i]);
+                        Vec2 acc = {pforce.x[i] / density, pforce.y[i] / density};
+                        if (n == 0) {
+                            velhalf.x[i] = vel.x[i] + 0.5 * h * acc.x;
+                            velhalf.y[i] = vel.y[i] + 0.5 * h * acc.y;
+                        } else {
+                            // 补全上一步的后半步速度，再推进前半步
+                            vel.x[i] = velhalf.x[i] + 0.5 * h * acc.x;
+                            vel.y[i] = velhalf.y[i] + 0.5 * h * acc.y;
+                            velhalf.x[i] = vel.x[i] + 0.5 * h * acc.x;
+                            velhalf.y[i] = vel.y[i] + 0.5 * h * acc.y;
+                        }
+                    }
+                    disp.x[i] = disp.x[i] + velhalf.x[i] * dt;
+                    disp.y[i] = disp.y[i] + velhalf.y[i] * dt;
+                }
+                for (size_t i = max(_i, static_cast<size_t>(totint)); i < _i + _ti; ++i) {
+                    applyBoundary(i, nextTime);
+                }
+                if (engine == FORCE_ENGINE_STENCIL) {
+                    mStencil.scatter(disp.x, disp.y, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                }
+            XTHREAD_PARALLELIZE_END
+            iterations = tt;
+
+            // --------------------- 断键压缩 ---------------------
+            compactBonds(tt);
+
+            // --------------------- 结果输出（特定时间步） ---------------------
+            if (isOutputStep(tt)) {
+                cout << "Time: " << nextTime << " s" << endl;
+                int retOutput = writeOutput(tt);
+                ASSERTER_WITH_RET(retOutput == NO_ERROR, retOutput);
+            }
+        }
+
+        cout << "Steps: " << iterations << ", time: " << iterations * dt << " s" << endl;
+        return NO_ERROR;
+    }
+
+    template<typename P, int Dim, typename Transport>
+    int PdSolver<P, Dim, Transport>::runQuasiStatic(int& iterations)
+    {
+        // 只求解 x、y 分量（三维与区域分解由 SimConfig::validate 拒绝）
+        const ForceEngine engine = mConfig.engine;
+        const int totint = mTotInt, tottop = mTotTop;
+        const size_t tileInt = tileOf(totint, mConfig.threads);
+
+        VecField disp = mState.disp();         // 位移
+        VecField pforce = mState.force();      // 不平衡力（无外力，即内力）
+
+        // 平衡迭代中不判断断键，断键在每个加载步求解完成后判断
+        vector<uint8_t> unbreakable(tottop, 0);
+        BasicBondKernelArgs<Real> solveArgs = mKernelArgs;
+        solveArgs.breakable = unbreakable.data();
+
+        PcgSolver<Real> pcg;
+        int retPcg = pcg.init(totint, tottop);
+        ASSERTER_WITH_RET(retPcg == NO_ERROR, retPcg);
+        vector<double> deltax(totint, 0.0), deltay(totint, 0.0); // 位移修正
+
+        // 未设置容差时按不平衡力 1e-6 判断收敛
+        ConvergencePolicy policy = mConfig.convergence;
+        if (policy.forceTolerance <= 0.0 && policy.dispTolerance <= 0.0) {
+            policy.forceTolerance = 1e-6;
+        }
+        policy.stableSteps = 0;
+        ResidualMonitor monitor;
+        monitor.init(policy);
+
+        // 计算内部粒子的键力，返回 ||f||^2 与 ||u||^2（args 决定是否断键）
+        framework::DeterministicReduce<2> residualReduce;
+        auto computeResidual = [&](const BasicBondKernelArgs<Real>& args, double (&sums)[2]) {
+            if (engine == FORCE_ENGINE_HALF_BOND) {
+                XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(totint, tileInt)
+                    computePairs(mHalfBondKernel, args, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                XTHREAD_PARALLELIZE_END
+            }
+            return residualReduce.run(totint, [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[2]) {
+                prefetchBonds(static_cast<int>(_i + _ti), static_cast<int>(_i + 2 * _ti));
+                computeForces(engine, mKernel, mHalfBondKernel, mStencil, args, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                for (size_t i = _i; i < _i + _ti; ++i) {
+                    partial[0].add(pforce.x[i] * pforce.x[i] + pforce.y[i] * pforce.y[i]);
+                    partial[1].add(disp.x[i] * disp.x[i] + disp.y[i] * disp.y[i]);
+                }
+            }, sums);
+        };
+        framework::DeterministicReduce<1> updateReduce;
+
+        // 加载步：未设置时一次施加最终边界位移
+        const int numIncrements = mConfig.convergence.loadSteps > 0 ? mConfig.convergence.loadSteps : 1;
+        int increment = 1;
+        size_t cgIterations = 0;
+        while (increment <= numIncrements && iterations < mConfig.steps) {
+            for (size_t i = totint; i < static_cast<size_t>(tottop); ++i) {
+                applyBoundary(i, loadTime(increment, numIncrements));
+            }
+            if (engine == FORCE_ENGINE_STENCIL) {
+                mStencil.scatter(disp.x, disp.y, totint, tottop);
+            }
+
+            // --------------------- 修正牛顿迭代：以线性化刚度求解位移修正 A du = f ---------------------
+            monitor.beginIncrement();
+            double dispIncrement2 = 0.0;
+            while (iterations < mConfig.steps) {
+                double sums[2];
+                int retResidual = computeResidual(solveArgs, sums);
+                ASSERTER_WITH_RET(retResidual == NO_ERROR, retResidual);
+                ++iterations;
+
+                monitor.update(iterations, sums[0], dispIncrement2, sums[1], 0);
+                cout << "Load step " << increment << "/" << numIncrements << ", iteration " << monitor.incrementIterations()
+                     << ", residual: force " << monitor.forceResidual() << ", disp " << monitor.dispResidual() << endl;
+                if (monitor.converged()) {
+                    break;
+                }
+
+                typename PcgSolver<Real>::Stats stats;
+                int retSolve = pcg.solve(solveArgs, pforce.x, pforce.y, deltax.data(), deltay.data(),
+                    mConfig.cgTolerance, mConfig.cgMaxIterations, stats);
+                ASSERTER_WITH_RET(retSolve == NO_ERROR, retSolve);
+                cgIterations += stats.iterations;
+
+                double increment2[1];
+                int retUpdate = updateReduce.run(totint, [&](size_t _i, size_t _ti, framework::CompensatedSum (&partial)[1]) {
+                    for (size_t i = _i; i < _i + _ti; ++i) {
+                        disp.x[i] += deltax[i];
+                        disp.y[i] += deltay[i];
+                        partial[0].add(deltax[i] * deltax[i] + deltay[i] * deltay[i]);
+                    }
+                    if (engine == FORCE_ENGINE_STENCIL) {
+                        mStencil.scatter(disp.x, disp.y, static_cast<int>(_i), static_cast<int>(_i + _ti));
+                    }
+                }, increment2);
+                ASSERTER_WITH_RET(retUpdate == NO_ERROR, retUpdate);
+                dispIncrement2 = increment2[0];
+            }
+
+            // --------------------- 断键判断：有新断键时以新的键状态重新求解本加载步 ---------------------
+            size_t brokenBefore = mDamage.numBroken();
+            double sums[2];
+            int retBreak = computeResidual(mKernelArgs, sums);
+            ASSERTER_WITH_RET(retBreak == NO_ERROR, retBreak);
+            size_t newlyBroken = mDamage.numBroken() - brokenBefore;
+            compactBonds(increment);
+            if (newlyBroken > 0) {
+                cout << "Load step " << increment << "/" << numIncrements << ": " << newlyBroken << " bonds broken, solving again" << endl;
+                continue;
+            }
+
+            // 加载步对应的伪时间步（与松弛求解相同加载下的输出文件名一致）
+            int step = static_cast<int>(static_cast<long long>(mConfig.steps) * increment / numIncrements);
+            if (isOutputStep(step)) {
+                int retOutput = writeOutput(step);
+                ASSERTER_WITH_RET(retOutput == NO_ERROR, retOutput);
+            }
+            ++increment;
+        }
+
+        cout << "Iterations: " << iterations << " (PCG " << cgIterations << "), load steps: "
+             << min(increment, numIncrements) << "/" << numIncrements << endl;
+        return NO_ERROR;
+    }
+
+    template class PdSolver<PrecisionFp64>;
+    template class PdSolver<PrecisionMixed>;
+    template class PdSolver<PrecisionFp32>;
+    template class PdSolver<PrecisionFp64, 3>;
+    template class PdSolver<PrecisionFp64, 2, ipc::ShmTransport>;
+    template class PdSolver<PrecisionFp64, 3, ipc::ShmTransport>;
+
+} // namespace caep
@@ -0,0 +1,252 @@
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include "caep.h"
+#include "sim_config.h"
+#include "precision.h"
+#include "dimension.h"
+#include "damage_tracker.h"
+#include "pd_solver.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    caep::SimConfig smallPlate()
+    {
+        caep::SimConfig config;
+        config.ndivx = 24;
+        config.ndivy = 24;
+        config.steps = 80;
+        config.velocity = 2.7541e-5;
+        config.outputSteps.clear();
+        config.threads = 2;
+        return config;
+    }
+
+    double maxAbs(const std::vector<double>& v)
+    {
+        double m = 0.0;
+        for (double x : v) {
+            m = std::max(m, std::abs(x));
+        }
+        return m;
+    }
+
+} // namespace
+
+TEST(PdSolver, ThickPlate)
+{
+    caep::SimConfig config = smallPlate();
+    config.dimension = 3;
+    config.ndivz = 4;
+    config.criticalStretch = 1.0;   // 只检查弹性响应
+
+    caep::PdSolver<caep::PrecisionFp64, 3> solver;
+    ASSERT_EQ(solver.init(config), NO_ERROR);
+    const int totint = solver.numActive();
+    ASSERT_EQ(totint % config.ndivz, 0);
+    EXPECT_LE(solver.numBonds(), static_cast<size_t>(solver.numTotal()) * 122);
+
+    HoleResult result;
+    ASSERT_EQ(solver.run(&result), NO_ERROR);
+    ASSERT_EQ(result.dispz.size(), static_cast<size_t>(totint));
+
+    // 拉伸方向为 y, 厚度方向收缩 (uz 与 z 反号) 且关于中面对称: 第 k 层与第 nz-1-k 层互为镜像
+    const int perLayer = totint / config.ndivz;
+    const double scale = maxAbs(result.dispy);
+    EXPECT_GT(scale, 0.0);
+    EXPECT_GT(maxAbs(result.dispz), 0.0);
+    EXPECT_LT(maxAbs(result.dispz), scale);
+    for (int k = 0; k < config.ndivz / 2; ++k) {
+        for (int p = 0; p < perLayer; ++p) {
+            int i = k * perLayer + p, j = (config.ndivz - 1 - k) * perLayer + p;
+            EXPECT_NEAR(result.dispx[i], result.dispx[j], 1e-9 * scale) << "particle " << i;
+            EXPECT_NEAR(result.dispy[i], result.dispy[j], 1e-9 * scale) << "particle " << i;
+            EXPECT_NEAR(result.dispz[i], -result.dispz[j], 1e-9 * scale) << "particle " << i;
+        }
+    }
+    double layerSum = 0.0;
+    for (int p = 0; p < perLayer; ++p) {
+        layerSum += result.dispz[p];
+    }
+    EXPECT_GT(layerSum, 0.0);   // 底层 (z < 0) 向中面收缩
+}
+
+TEST(PdSolver, MappedBondStorage)
+{
+    caep::SimConfig config = smallPlate();
+    HoleResult ref, result;
+    ASSERT_EQ(demo_hole(config, &ref), NO_ERROR);
+
+    // 键表与键几何存放在当前目录下的临时映射文件中, 结果应与内存中完全相同
+    config.bondStorage = ".";
+    ASSERT_EQ(demo_hole(config, &result), NO_ERROR);
+    ASSERT_EQ(result.dispx.size(), ref.dispx.size());
+    EXPECT_EQ(result.numBroken, ref.numBroken);
+    for (size_t i = 0; i < ref.dispx.size(); ++i) {
+        EXPECT_EQ(result.dispx[i], ref.dispx[i]) << "particle " << i;
+        EXPECT_EQ(result.dispy[i], ref.dispy[i]) << "particle " << i;
+    }
+
+    config.bondStorage = "./no-such-directory";
+    EXPECT_NE(demo_hole(config, &result), NO_ERROR);
+}
+
+TEST(PdSolver, DomainDecomposition)
+{
+    // 三个本机进程: 键力与幽灵层位移逐位一致, 只有 ADR 全局和的求和顺序不同 (阻尼系数在最后几位上不同)
+    caep::SimConfig config = smallPlate();
+    config.criticalStretch = 0.002;
+    HoleResult ref, result;
+    ASSERT_EQ(demo_hole(config, &ref), NO_ERROR);
+    ASSERT_GT(ref.numBroken, 0u);
+
+    config.ranks = 3;
+    ASSERT_EQ(demo_hole(config, &result), NO_ERROR);
+    ASSERT_EQ(result.dispx.size(), ref.dispx.size());
+    EXPECT_EQ(result.numBroken, ref.numBroken);
+    const double scale = std::max(maxAbs(ref.dispx), maxAbs(ref.dispy));
+    for (size_t i = 0; i < ref.dispx.size(); ++i) {
+        EXPECT_NEAR(result.dispx[i], ref.dispx[i], 1e-9 * scale) << "particle " << i;
+        EXPECT_NEAR(result.dispy[i], ref.dispy[i], 1e-9 * scale) << "particle " << i;
+        EXPECT_DOUBLE_EQ(result.damage[i], ref.damage[i]) << "particle " << i;
+    }
+
+    // 三维厚板, 两个进程
+    config = smallPlate();
+    config.dimension = 3;
+    config.ndivz = 4;
+    config.steps = 40;
+    ASSERT_EQ(demo_hole(config, &ref), NO_ERROR);
+    config.ranks = 2;
+    ASSERT_EQ(demo_hole(config, &result), NO_ERROR);
+    ASSERT_EQ(result.dispz.size(), ref.dispz.size());
+    const double scale3 = maxAbs(ref.dispy);
+    for (size_t i = 0; i < ref.dispz.size(); ++i) {
+        EXPECT_NEAR(result.dispy[i], ref.dispy[i], 1e-9 * scale3) << "particle " << i;
+        EXPECT_NEAR(result.dispz[i], ref.dispz[i], 1e-9 * scale3) << "particle " << i;
+    }
+}
+
+TEST(PdSolver, GradedResolution)
+{
+    // 孔边间距 dx, 远处 4 dx: 孔附近的弹性位移与均匀的细粒子接近, 粒子数少得多
+    caep::SimConfig config = smallPlate();
+    config.ndivx = 64;
+    config.ndivy = 64;
+    config.steps = 400;
+    config.velocity = 2.7541e-6;
+    config.criticalStretch = 1.0;
+    HoleResult ref, result;
+    caep::PdSolver<caep::PrecisionFp64> uniform;
+    ASSERT_EQ(uniform.init(config), NO_ERROR);
+    ASSERT_EQ(uniform.run(&ref), NO_ERROR);
+
+    config.refineLevels = 2;
+    config.refineWidth = 0.003;
+    caep::PdSolver<caep::PrecisionFp64> graded;
+    ASSERT_EQ(graded.init(config), NO_ERROR);
+    EXPECT_LT(graded.numTotal() * 3, uniform.numTotal());
+    ASSERT_EQ(graded.run(&result), NO_ERROR);
+    EXPECT_EQ(result.numBroken, 0u);
+
+    // 孔边 2 mm 内的粒子都是最细一层, 位置与均匀粒子相同 (按半间距取整作为键, 关于 x = 0 对称)
+    const double dx = config.dx(), band = config.holeRadius + 0.002;
+    auto key = [dx](const caep::Vec2& p) {
+        return std::make_pair(std::lround(2.0 * p.x / dx), std::lround(2.0 * p.y / dx));
+    };
+    std::map<std::pair<long, long>, int> uniformIds;
+    for (int i = 0; i < uniform.numActive(); ++i) {
+        uniformIds[key(uniform.points()[i])] = i;
+    }
+    const double scale = std::max(maxAbs(ref.dispx), maxAbs(ref.dispy));
+    int matched = 0;
+    for (int i = 0; i < graded.numActive(); ++i) {
+        const caep::Vec2& p = graded.points()[i];
+        if (std::sqrt(p.x*p.x + p.y*p.y) > band) {
+            continue;
+        }
+        auto found = uniformIds.find(key(p));
+        ASSERT_TRUE(found != uniformIds.end()) << "particle " << i << " is not on the fine lattice";
+        int j = found->second;
+        EXPECT_NEAR(result.dispx[i], ref.dispx[j], 0.02 * scale) << "particle " << i;
+        EXPECT_NEAR(result.dispy[i], ref.dispy[j], 0.02 * scale) << "particle " << i;
+        ++matched;
+    }
+    EXPECT_GT(matched, 100);
+
+    // 左右对称
+    std::map<std::pair<long, long>, int> gradedIds;
+    for (int i = 0; i < graded.numActive(); ++i) {
+        gradedIds[key(graded.points()[i])] = i;
+    }
+    for (int i = 0; i < graded.numActive(); ++i) {
+        const caep::Vec2& p = graded.points()[i];
+        auto mirror = gradedIds.find(key({-p.x, p.y}));
+        ASSERT_TRUE(mirror != gradedIds.end()) << "particle " << i;
+        EXPECT_NEAR(result.dispx[i], -result.dispx[mirror->second], 1e-9 * scale) << "particle " << i;
+        EXPECT_NEAR(result.dispy[i], result.dispy[mirror->second], 1e-9 * scale) << "particle " << i;
+    }
+
+    // 区域分解: 前几十步与单个进程逐位一致 (之后 ADR 全局和的求和顺序使阻尼系数略有不同)
+    config.steps = 20;
+    HoleResult serial, partitioned;
+    ASSERT_EQ(demo_hole(config, &serial), NO_ERROR);
+    config.ranks = 2;
+    ASSERT_EQ(demo_hole(config, &partitioned), NO_ERROR);
+    ASSERT_EQ(partitioned.dispx.size(), serial.dispx.size());
+    for (size_t i = 0; i < serial.dispx.size(); ++i) {
+        EXPECT_NEAR(partitioned.dispx[i], serial.dispx[i], 1e-9 * scale) << "particle " << i;
+        EXPECT_NEAR(partitioned.dispy[i], serial.dispy[i], 1e-9 * scale) << "particle " << i;
+    }
+}
+
+TEST(PdSolver, BreakSubsteps)
+{
+    // 第 5 步开始断键, 默认 (断键下一步生效) 到第 9 步才基本稳定, 在裂纹扩展中的第 6 步比较
+    caep::SimConfig config = smallPlate();
+    config.criticalStretch = 0.002;
+    config.steps = 6;
+    HoleResult ref, result;
+    ASSERT_EQ(demo_hole(config, &ref), NO_ERROR);
+    ASSERT_GT(ref.numBroken, 0u);
+
+    // breakSubsteps = 0: 断键下一步生效, 与默认逐位一致
+    ASSERT_EQ(config.set("break-substeps", "0"), NO_ERROR);
+    ASSERT_EQ(demo_hole(config, &result), NO_ERROR);
+    ASSERT_EQ(result.dispx.size(), ref.dispx.size());
+    EXPECT_EQ(result.numBroken, ref.numBroken);
+    for (size_t i = 0; i < ref.dispx.size(); ++i) {
+        EXPECT_EQ(result.dispx[i], ref.dispx[i]) << "particle " << i;
+        EXPECT_EQ(result.dispy[i], ref.dispy[i]) << "particle " << i;
+        EXPECT_EQ(result.damage[i], ref.damage[i]) << "particle " << i;
+    }
+
+    // 断键在本步内生效并局部松弛: 同一步的断键不少于默认
+    config.breakSubsteps = 8;
+    caep::PdSolver<caep::PrecisionFp64> solver;
+    ASSERT_EQ(solver.init(config), NO_ERROR);
+    ASSERT_EQ(solver.run(&result), NO_ERROR);
+    EXPECT_GE(result.numBroken, ref.numBroken);
+
+    // 局部重算后每条断键只计一次: 断键数与键表的有效位一致, 损伤与按有效位重新统计的相同
+    const caep::BondTable& bonds = solver.bonds();
+    const int numActive = solver.numActive();
+    size_t numDead = 0;
+    for (int i = 0; i < numActive; ++i) {
+        for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+            numDead += bonds.isAlive(b) ? 0 : 1;
+        }
+    }
+    EXPECT_EQ(numDead, result.numBroken);
+
+    std::vector<double> damage(numActive);
+    caep::DamageTracker tracker;
+    ASSERT_EQ(tracker.init(bonds, solver.geometry().fac(), caep::Dimension<2>::volume(config.dx(), config.dx()),
+        numActive, damage.data()), NO_ERROR);
+    ASSERT_EQ(result.damage.size(), damage.size());
+    for (int i = 0; i < numActive; ++i) {
+        EXPECT_NEAR(result.damage[i], damage[i], 1e-12) << "particle " << i;
+    }
+}
@@ -0,0 +1,75 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#define TAG_LOGGER "[CAEP]"
+#include "logger.h"
+
+#include "caep.h"
+#include "sim_config.h"
+#include "timer.h"
+
+
+namespace {
+
+    // 相对 fp64 的误差: 位移以 fp64 的最大位移归一化, 损伤为绝对误差
+    struct PrecisionError {
+        double dispMax;
+        double dispRms;
+        double damageMax;
+        size_t damageDiffer;    // 损伤不同的粒子数
+    };
+
+    PrecisionError compare(const HoleResult& result, const HoleResult& reference)
+    {
+        double scale = 0.0;
+        for (size_t i = 0; i < reference.dispx.size(); ++i) {
+            scale = std::max(scale, std::hypot(reference.dispx[i], reference.dispy[i]));
+        }
+        scale = scale > 0.0 ? scale : 1.0;
+
+        PrecisionError error = {0.0, 0.0, 0.0, 0};
+        double sum = 0.0;
+        for (size_t i = 0; i < reference.dispx.size(); ++i) {
+            double e = std::hypot(result.dispx[i] - reference.dispx[i], result.dispy[i] - reference.dispy[i]) / scale;
+            error.dispMax = std::max(error.dispMax, e);
+            sum += e * e;
+
+            double d = std::abs(result.damage[i] - reference.damage[i]);
+            error.damageMax = std::max(error.damageMax, d);
+            error.damageDiffer += d > 0.0 ? 1 : 0;
+        }
+        error.dispRms = reference.dispx.empty() ? 0.0 : std::sqrt(sum / reference.dispx.size());
+        return error;
+    }
+
+} // namespace
+
+int precision_hole(const caep::SimConfig& config)
+{
+    const Precision precisions[] = {PRECISION_FP64, PRECISION_MIXED, PRECISION_FP32};
+    const char* names[] = {"fp64", "mixed", "fp32"};
+
+    HoleResult results[3];
+    float elapsed[3];
+    for (int k = 0; k < 3; ++k) {
+        caep::SimConfig run = config;
+        run.engine = FORCE_ENGINE_BOND;
+        run.precision = precisions[k];
+        perf::Timer timer;
+        int retDemo = demo_hole(run, &results[k]);
+        ASSERTER_WITH_RET(retDemo == NO_ERROR, retDemo);
+        elapsed[k] = timer.count();
+    }
+
+    LOGGER_I("precision (demo_hole, %zu threads), errors relative to fp64\n", config.threads);
+    LOGGER_I("%8s %12s %9s %12s %12s %12s %10s %8s\n", "mode", "time(ms)", "speedup",
+        "disp(max)", "disp(rms)", "damage(max)", "damage!=", "broken");
+    for (int k = 0; k < 3; ++k) {
+        PrecisionError error = compare(results[k], results[0]);
+        LOGGER_I("%8s %12.1f %9.2f %12.3e %12.3e %12.3e %10zu %8zu\n", names[k], elapsed[k], elapsed[0] / elapsed[k],
+            error.dispMax, error.dispRms, error.damageMax, error.damageDiffer, results[k].numBroken);
+    }
+
+    return NO_ERROR;
+}
@@ -0,0 +1,173 @@
+#include <cmath>
+#include <algorithm>
+#include "relaxation_integrator.h"
+
+
+namespace caep {
+
+    namespace {
+
+        // 各字段的分量起始地址
+        template<int Dim>
+        void bindFields(const BasicParticleState<Dim>& state, double* (&disp)[Dim], double* (&vel)[Dim], double* (&force)[Dim],
+            double* (&forceOld)[Dim], double* (&velHalfOld)[Dim], double* (&mass)[Dim])
+        {
+            for (int d = 0; d < Dim; ++d) {
+                disp[d] = state.disp().component(d);
+                vel[d] = state.vel().component(d);
+                force[d] = state.force().component(d);
+                forceOld[d] = state.forceOld().component(d);
+                velHalfOld[d] = state.velHalfOld().component(d);
+                mass[d] = state.mass().component(d);
+            }
+        }
+
+    } // namespace
+
+    template<int Dim>
+    BasicAdrIntegrator<Dim>::BasicAdrIntegrator()
+        : mDisp(), mVel(), mForce(), mForceOld(), mVelHalfOld(), mMass(), mDt(0.0), mCn(0.0), mFirst(true)
+    {
+        ;
+    }
+
+    template<int Dim>
+    void BasicAdrIntegrator<Dim>::init(const BasicParticleState<Dim>& state, double dt)
+    {
+        bindFields(state, mDisp, mVel, mForce, mForceOld, mVelHalfOld, mMass);
+        mDt = dt;
+        mCn = 0.0;
+        mFirst = true;
+    }
+
+    template<int Dim>
+    void BasicAdrIntegrator<Dim>::accumulate(size_t begin, size_t end, framework::CompensatedSum* partial) const
+    {
+        const double dt = mDt;
+        for (size_t i = begin; i < end; ++i) {
+            for (int d = 0; d < Dim; ++d) {
+                if (mVelHalfOld[d][i] != 0.0) {
+                    double acc_diff = (mForce[d][i] - mForceOld[d][i]) / mMass[d][i];
+                    partial[0].add(-mDisp[d][i] * mDisp[d][i] * acc_diff / (dt * mVelHalfOld[d][i]));
+                }
+            }
+        }
+    }
+
+    template<int Dim>
+    void BasicAdrIntegrator<Dim>::prepare(int step, const double* sums, double dispNorm2, double /*forceNorm2*/)
+    {
+        double cn = 0.0, cn1 = sums[0], cn2 = dispNorm2;
+        if (cn2 > 1e-10) {
+            cn = (cn1 / cn2 > 0.0) ? 2.0 * std::sqrt(cn1 / cn2) : 0.0;
+        }
+        mCn = std::min(cn, 1.9); // 限制最大松弛系数
+        mFirst = step == 1;
+    }
+
+    template<int Dim>
+    void BasicAdrIntegrator<Dim>::update(size_t begin, size_t end)
+    {
+        const double dt = mDt, cn = mCn;
+        for (size_t i = begin; i < end; ++i) {
+            for (int d = 0; d < Dim; ++d) {
+                double velhalf;
+                if (mFirst) { // 初始时间步特殊处理
+                    velhalf = dt * (mForce[d][i]) / (2 * mMass[d][i]);
+                } else {
+                    // ADR算法更新半时间步速度
+                    velhalf = ((2.0 - cn * dt) * mVelHalfOld[d][i] + 2.0 * dt * mForce[d][i] / mMass[d][i]) / (2.0 + cn * dt);
+                }
+
+                // 更新全时间步速度和位移
+                mVel[d][i] = (mVelHalfOld[d][i] + velhalf) * 0.5;
+                mDisp[d][i] = mDisp[d][i] + velhalf * dt;
+
+                // 保存半步速度和前步力（用于下一步计算）
+                mVelHalfOld[d][i] = velhalf;
+                mForceOld[d][i] = mForce[d][i];
+            }
+        }
+    }
+
+    template<int Dim>
+    BasicFireIntegrator<Dim>::BasicFireIntegrator(const Params& params)
+        : mParams(params), mDisp(), mVel(), mForce(), mForceOld(), mVelHalfOld(), mMass(),
+          mDt0(0.0), mDt(0.0), mAlpha(params.alphaStart), mNumPositive(0), mKeep(1.0), mMix(0.0)
+    {
+        ;
+    }
+
+    template<int Dim>
+    void BasicFireIntegrator<Dim>::init(const BasicParticleState<Dim>& state, double dt)
+    {
+        bindFields(state, mDisp, mVel, mForce, mForceOld, mVelHalfOld, mMass);
+        mDt0 = dt;
+        mDt = dt * mParams.startDtRatio;
+        mAlpha = mParams.alphaStart;
+        mNumPositive = 0;
+        mKeep = 1.0;
+        mMix = 0.0;
+    }
+
+    template<int Dim>
+    void BasicFireIntegrator<Dim>::accumulate(size_t begin, size_t end, framework::CompensatedSum* partial) const
+    {
+        for (size_t i = begin; i < end; ++i) {
+            double power = mForce[0][i] * mVelHalfOld[0][i];
+            double velNorm2 = mVelHalfOld[0][i] * mVelHalfOld[0][i];
+            for (int d = 1; d < Dim; ++d) {
+                power += mForce[d][i] * mVelHalfOld[d][i];
+                velNorm2 += mVelHalfOld[d][i] * mVelHalfOld[d][i];
+            }
+            partial[0].add(power);
+            partial[1].add(velNorm2);
+        }
+    }
+
+    template<int Dim>
+    void BasicFireIntegrator<Dim>::prepare(int /*step*/, const double* sums, double /*dispNorm2*/, double forceNorm2)
+    {
+        const double power = sums[0], velNorm2 = sums[1];
+        if (power > 0.0) {
+            mKeep = 1.0 - mAlpha;
+            mMix = forceNorm2 > 0.0 ? mAlpha * std::sqrt(velNorm2 / forceNorm2) : 0.0;
+            if (++mNumPositive > mParams.minPositive) {
+                mDt = std::min(mDt * mParams.dtGrow, mDt0 * mParams.maxDtRatio);
+                mAlpha *= mParams.alphaShrink;
+            }
+        } else {
+            // 越过能量极小值: 停止运动并减小步长 (初始静止状态 P = 0, 不减小步长)
+            mKeep = 0.0;
+            mMix = 0.0;
+            if (velNorm2 > 0.0) {
+                mDt *= mParams.dtShrink;
+            }
+            mAlpha = mParams.alphaStart;
+            mNumPositive = 0;
+        }
+    }
+
+    template<int Dim>
+    void BasicFireIntegrator<Dim>::update(size_t begin, size_t end)
+    {
+        const double dt = mDt, keep = mKeep, mix = mMix;
+        for (size_t i = begin; i < end; ++i) {
+            for (int d = 0; d < Dim; ++d) {
+                double v = keep * mVelHalfOld[d][i] + mix * mForce[d][i] + dt * mForce[d][i] / mMass[d][i];
+
+                mVel[d][i] = v;
+                mDisp[d][i] = mDisp[d][i] + v * dt;
+
+                mVelHalfOld[d][i] = v;
+                mForceOld[d][i] = mForce[d][i];
+            }
+        }
+    }
+
+    template class BasicAdrIntegrator<2>;
+    template class BasicAdrIntegrator<3>;
+    template class BasicFireIntegrator<2>;
+    template class BasicFireIntegrator<3>;
+
+} // namespace caep
@@ -0,0 +1,71 @@
+#include <cmath>
+#include "relaxation_integrator.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    // 互不耦合的弹簧 f = -k u (k 在 [0.1, 1] 之间), 质量为 1, 初始位移各分量为 +-1, 平衡位置为 0
+    template<int Dim, typename Integrator>
+    int relax(Integrator& integrator, int maxSteps, double tolerance)
+    {
+        const size_t n = 8;
+        caep::BasicParticleState<Dim> state;
+        EXPECT_EQ(state.init(n), NO_ERROR);
+        double* disp[Dim];
+        double* force[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            disp[d] = state.disp().component(d);
+            force[d] = state.force().component(d);
+            for (size_t i = 0; i < n; ++i) {
+                disp[d][i] = d % 2 == 0 ? 1.0 : -1.0;
+                state.mass().component(d)[i] = 1.0;
+            }
+        }
+
+        integrator.init(state, 1.0);
+        for (int step = 1; step <= maxSteps; ++step) {
+            framework::CompensatedSum partial[3 + Integrator::NUM_SUMS];
+            for (size_t i = 0; i < n; ++i) {
+                double k = 0.1 + 0.9 * i / (n - 1);
+                for (int d = 0; d < Dim; ++d) {
+                    force[d][i] = -k * disp[d][i];
+                    partial[0].add(disp[d][i] * disp[d][i]);
+                    partial[1].add(force[d][i] * force[d][i]);
+                }
+            }
+            if (std::sqrt(partial[0].result()) < tolerance) {
+                return step;
+            }
+            integrator.accumulate(0, n, partial + 3);
+
+            double sums[Integrator::NUM_SUMS];
+            for (int k = 0; k < Integrator::NUM_SUMS; ++k) {
+                sums[k] = partial[3 + k].result();
+            }
+            integrator.prepare(step, sums, partial[0].result(), partial[1].result());
+            integrator.update(0, n);
+        }
+        return maxSteps + 1;
+    }
+
+} // namespace
+
+TEST(RelaxationIntegrator, Springs)
+{
+    caep::AdrIntegrator adr;
+    int adrSteps = relax<2>(adr, 2000, 1e-6);
+    EXPECT_LE(adrSteps, 2000);
+    EXPECT_DOUBLE_EQ(adr.timeStep(), 1.0);
+
+    caep::FireIntegrator fire;
+    int fireSteps = relax<2>(fire, 2000, 1e-6);
+    EXPECT_LE(fireSteps, 2000);
+    EXPECT_LE(fire.timeStep(), 1.0);    // 步长不超过 maxDtRatio * dt
+
+    // 三维各分量按相同公式积分 (接近收敛时阻尼系数的估计受舍入影响, 步数不必与二维相同)
+    caep::BasicAdrIntegrator<3> adr3;
+    EXPECT_LE(relax<3>(adr3, 2000, 1e-6 * std::sqrt(1.5)), 2000);
+    caep::BasicFireIntegrator<3> fire3;
+    EXPECT_LE(relax<3>(fire3, 2000, 1e-6 * std::sqrt(1.5)), 2000);
+}
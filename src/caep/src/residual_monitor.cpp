@@ -0,0 +1,60 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "residual_monitor.h"
+
+
+namespace caep {
+
+    ResidualMonitor::ResidualMonitor()
+        : mPolicy(), mPeakForceNorm2(0.0), mForceResidual(0.0), mDispResidual(0.0),
+          mIncrementIterations(0), mIteration(0), mLastBreak(std::numeric_limits<int>::min() / 2), mNumBroken(0)
+    {
+        ;
+    }
+
+    void ResidualMonitor::init(const ConvergencePolicy& policy)
+    {
+        *this = ResidualMonitor();
+        mPolicy = policy;
+    }
+
+    void ResidualMonitor::beginIncrement()
+    {
+        mPeakForceNorm2 = 0.0;
+        mIncrementIterations = 0;
+    }
+
+    void ResidualMonitor::update(int iteration, double forceNorm2, double dispIncrementNorm2, double dispNorm2, size_t numBroken)
+    {
+        mIteration = iteration;
+        ++mIncrementIterations;
+        if (numBroken != mNumBroken) {
+            mNumBroken = numBroken;
+            mLastBreak = iteration;
+        }
+
+        mPeakForceNorm2 = std::max(mPeakForceNorm2, forceNorm2);
+        mForceResidual = mPeakForceNorm2 > 0.0 ? std::sqrt(forceNorm2 / mPeakForceNorm2) : 0.0;
+
+        if (dispIncrementNorm2 <= 0.0) {
+            mDispResidual = 0.0;
+        } else {
+            mDispResidual = dispNorm2 > 0.0 ? std::sqrt(dispIncrementNorm2 / dispNorm2) : std::numeric_limits<double>::infinity();
+        }
+    }
+
+    bool ResidualMonitor::converged() const
+    {
+        if (!enabled() || mIncrementIterations < 2) {
+            return false;
+        }
+        if (mIteration - mLastBreak < mPolicy.stableSteps) {
+            return false;
+        }
+        bool forceOk = mPolicy.forceTolerance <= 0.0 || mForceResidual < mPolicy.forceTolerance;
+        bool dispOk = mPolicy.dispTolerance <= 0.0 || mDispResidual < mPolicy.dispTolerance;
+        return forceOk && dispOk;
+    }
+
+} // namespace caep
@@ -0,0 +1,48 @@
+#include "residual_monitor.h"
+#include "gtest/gtest.h"
+
+
+TEST(ResidualMonitor, Convergence)
+{
+    caep::ResidualMonitor monitor;
+    ConvergencePolicy policy = {4, 1e-3, 1e-4, 2};
+
+    // 未设置容差时从不收敛
+    monitor.init(ConvergencePolicy());
+    monitor.beginIncrement();
+    monitor.update(1, 0.0, 0.0, 1.0, 0);
+    monitor.update(2, 0.0, 0.0, 1.0, 0);
+    EXPECT_FALSE(monitor.enabled());
+    EXPECT_FALSE(monitor.converged());
+
+    monitor.init(policy);
+    monitor.beginIncrement();
+    monitor.update(1, 1.0, 1.0, 1.0, 0);
+    EXPECT_DOUBLE_EQ(monitor.forceResidual(), 1.0);
+    EXPECT_FALSE(monitor.converged());  // 本加载步只迭代了一次
+
+    // 不平衡力相对峰值 1e-4, 位移增量相对 1e-5
+    monitor.update(2, 1e-8, 1e-10, 1.0, 0);
+    EXPECT_DOUBLE_EQ(monitor.forceResidual(), 1e-4);
+    EXPECT_DOUBLE_EQ(monitor.dispResidual(), 1e-5);
+    EXPECT_TRUE(monitor.converged());
+
+    // 出现新断键后需连续 stableSteps 次迭代没有断键
+    monitor.update(3, 1e-8, 1e-10, 1.0, 5);
+    EXPECT_FALSE(monitor.converged());
+    monitor.update(4, 1e-8, 1e-10, 1.0, 5);
+    EXPECT_FALSE(monitor.converged());
+    monitor.update(5, 1e-8, 1e-10, 1.0, 5);
+    EXPECT_TRUE(monitor.converged());
+
+    // 位移增量未收敛
+    monitor.update(6, 1e-8, 1e-6, 1.0, 5);
+    EXPECT_FALSE(monitor.converged());
+
+    // 新加载步重新统计峰值与迭代次数
+    monitor.beginIncrement();
+    monitor.update(7, 1e-8, 1e-10, 1.0, 5);
+    EXPECT_EQ(monitor.incrementIterations(), 1);
+    EXPECT_DOUBLE_EQ(monitor.forceResidual(), 1.0);
+    EXPECT_FALSE(monitor.converged());
+}
@@ -0,0 +1,39 @@
+#include <vector>
+
+#define TAG_LOGGER "[CAEP]"
+#include "logger.h"
+
+#include "caep.h"
+#include "sim_config.h"
+#include "timer.h"
+
+
+int scaling_hole(const caep::SimConfig& config, size_t maxThreads)
+{
+    ASSERTER_WITH_RET(maxThreads > 0, ERROR_INVALID_PARAMETER);
+
+    std::vector<size_t> threads;
+    for (size_t t = 1; t < maxThreads; t *= 2) {
+        threads.push_back(t);
+    }
+    threads.push_back(maxThreads);
+
+    std::vector<float> elapsed;
+    for (size_t t : threads) {
+        caep::SimConfig run = config;
+        run.threads = t;
+        perf::Timer timer;
+        int retDemo = demo_hole(run);
+        ASSERTER_WITH_RET(retDemo == NO_ERROR, retDemo);
+        elapsed.push_back(timer.count());
+    }
+
+    LOGGER_I("strong scaling (demo_hole, %zu threads max)\n", maxThreads);
+    LOGGER_I("%8s %12s %10s %12s\n", "threads", "time(ms)", "speedup", "efficiency");
+    for (size_t k = 0; k < threads.size(); ++k) {
+        float speedup = elapsed[0] / elapsed[k];
+        LOGGER_I("%8zu %12.1f %10.2f %11.1f%%\n", threads[k], elapsed[k], speedup, 100.0f * speedup / threads[k]);
+    }
+
+    return NO_ERROR;
+}
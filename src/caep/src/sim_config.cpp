@@ -0,0 +1,362 @@
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cctype>
+#include <sstream>
+
+#define TAG_LOGGER "[CAEP]"
+#include "logger.h"
+
+#include "sim_config.h"
+#include "xjson.h"
+
+
+namespace caep {
+
+    namespace {
+
+        // hole-radius -> holeRadius
+        std::string toCamelCase(const std::string& name)
+        {
+            std::string key;
+            bool upper = false;
+            for (char c : name) {
+                if (c == '-' || c == '_') {
+                    upper = true;
+                    continue;
+                }
+                key += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+                upper = false;
+            }
+            return key;
+        }
+
+        bool parseDouble(const std::string& value, double& out)
+        {
+            char* end = nullptr;
+            double v = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0') {
+                return false;
+            }
+            out = v;
+            return true;
+        }
+
+        // 超出 int 范围的值视为无效 (不截断)
+        bool parseInt(const std::string& value, int& out)
+        {
+            char* end = nullptr;
+            errno = 0;
+            long v = std::strtol(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0' || errno == ERANGE || v < INT_MIN || v > INT_MAX) {
+                return false;
+            }
+            out = static_cast<int>(v);
+            return true;
+        }
+
+        // 命令行开关不带值时视为 true
+        bool parseBool(const std::string& value, bool& out)
+        {
+            if (value.empty() || value == "true" || value == "1") {
+                out = true;
+            } else if (value == "false" || value == "0") {
+                out = false;
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        bool parseMethod(const std::string& value, SolverMethod& out)
+        {
+            if (value == "relaxation") {
+                out = SOLVER_RELAXATION;
+            } else if (value == "pcg") {
+                out = SOLVER_PCG;
+            } else if (value == "dynamic") {
+                out = SOLVER_DYNAMIC;
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        bool parseIntegrator(const std::string& value, Integrator& out)
+        {
+            if (value == "adr") {
+                out = INTEGRATOR_ADR;
+            } else if (value == "fire") {
+                out = INTEGRATOR_FIRE;
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        bool parseEngine(const std::string& value, ForceEngine& out)
+        {
+            if (value == "bond") {
+                out = FORCE_ENGINE_BOND;
+            } else if (value == "half-bond") {
+                out = FORCE_ENGINE_HALF_BOND;
+            } else if (value == "stencil") {
+                out = FORCE_ENGINE_STENCIL;
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        bool parsePrecision(const std::string& value, Precision& out)
+        {
+            if (value == "fp64") {
+                out = PRECISION_FP64;
+            } else if (value == "mixed") {
+                out = PRECISION_MIXED;
+            } else if (value == "fp32") {
+                out = PRECISION_FP32;
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        bool parseSteps(const std::string& value, std::vector<int>& out)
+        {
+            std::vector<int> steps;
+            std::stringstream ss(value);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                int step = 0;
+                if (!parseInt(item, step)) {
+                    return false;
+                }
+                steps.push_back(step);
+            }
+            out.swap(steps);
+            return true;
+        }
+
+        // JSON 叶子值转换为 set() 接受的字符串
+        bool toString(const json::XJsonValue& value, std::string& out)
+        {
+            if (value.isString()) {
+                out = value.getString();
+            } else if (value.isBool()) {
+                out = value.getBool() ? "true" : "false";
+            } else if (value.isNumber()) {
+                std::ostringstream os;
+                os.precision(17);
+                os << value.getDouble();
+                out = os.str();
+            } else if (value.isArray()) {
+                std::ostringstream os;
+                for (size_t k = 0; k < value.getArraySize(); ++k) {
+                    json::XJsonValue item = value[k];
+                    if (!item.isNumber()) {
+                        return false;
+                    }
+                    os << (k > 0 ? "," : "") << item.getInt();
+                }
+                out = os.str();
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+    } // namespace
+
+    SimConfig::SimConfig()
+        : dimension(2), ndivx(100), ndivy(100), ndivz(10), nband(3), length(0.05), width(0.05), holeRadius(0.005), horizon(3.015),
+          refineLevels(0), refineWidth(0.0025),
+          density(8000.0), youngModulus(192.0e9), criticalStretch(0.02),
+          velocity(2.7541e-7),
+          steps(1000), dt(1.0), outputSteps({675, 750, 825, 1000}), safetyFactor(0.8), subcycleLevels(0), convergence{0, 0.0, 0.0, 10},
+          cgTolerance(1e-8), cgMaxIterations(2000),
+          method(SOLVER_RELAXATION), integrator(INTEGRATOR_ADR), threads(1), engine(FORCE_ENGINE_BOND), precision(PRECISION_FP64), reorder(false), compaction(CompactionPolicy()), breakSubsteps(0), bondStorage(), ranks(1)
+    {
+        ;
+    }
+
+    int SimConfig::load(const std::string& filename)
+    {
+        json::XJson config(filename);
+        ASSERTER_WITH_INFO(config.isValid(), ERROR_BAD_FORMAT, "failed to load config '%s'", filename.c_str());
+
+        const char* sections[][16] = {
+            {"problem", "dimension", "ndivx", "ndivy", "ndivz", "nband", "length", "width", "holeRadius", "horizon", "refineLevels", "refineWidth", nullptr},
+            {"material", "density", "youngModulus", "criticalStretch", nullptr},
+            {"loading", "velocity", nullptr},
+            {"time", "steps", "dt", "outputSteps", "safetyFactor", "subcycleLevels", nullptr},
+            {"convergence", "loadSteps", "forceTolerance", "dispTolerance", "stableSteps", "cgTolerance", "cgMaxIterations", nullptr},
+            {"solver", "method", "integrator", "threads", "engine", "precision", "reorder", "compactEvery", "compactThreshold", "breakSubsteps", "bondStorage", "ranks", nullptr},
+        };
+        for (const auto& section : sections) {
+            if (!config.contains(section[0])) {
+                continue;
+            }
+            json::XJsonValue group = config[section[0]];
+            ASSERTER_WITH_INFO(group.isObject(), ERROR_BAD_FORMAT, "'%s' is not an object", section[0]);
+            for (const char* const* key = section + 1; *key != nullptr; ++key) {
+                json::XJsonValue value = group[*key];
+                if (!value.isValid()) {
+                    continue;
+                }
+                std::string text;
+                ASSERTER_WITH_INFO(toString(value, text), ERROR_BAD_FORMAT, "invalid value of '%s.%s'", section[0], *key);
+                int retSet = set(*key, text);
+                ASSERTER_WITH_RET(retSet == NO_ERROR, retSet);
+            }
+        }
+        return NO_ERROR;
+    }
+
+    int SimConfig::set(const std::string& name, const std::string& value)
+    {
+        const std::string key = toCamelCase(name);
+
+        bool ok = false;
+        if (key == "dimension") {
+            ok = parseInt(value, dimension);
+        } else if (key == "ndivx") {
+            ok = parseInt(value, ndivx);
+        } else if (key == "ndivy") {
+            ok = parseInt(value, ndivy);
+        } else if (key == "ndivz") {
+            ok = parseInt(value, ndivz);
+        } else if (key == "nband") {
+            ok = parseInt(value, nband);
+        } else if (key == "length") {
+            ok = parseDouble(value, length);
+        } else if (key == "width") {
+            ok = parseDouble(value, width);
+        } else if (key == "holeRadius") {
+            ok = parseDouble(value, holeRadius);
+        } else if (key == "horizon") {
+            ok = parseDouble(value, horizon);
+        } else if (key == "refineLevels") {
+            ok = parseInt(value, refineLevels);
+        } else if (key == "refineWidth") {
+            ok = parseDouble(value, refineWidth);
+        } else if (key == "density") {
+            ok = parseDouble(value, density);
+        } else if (key == "youngModulus") {
+            ok = parseDouble(value, youngModulus);
+        } else if (key == "criticalStretch") {
+            ok = parseDouble(value, criticalStretch);
+        } else if (key == "velocity") {
+            ok = parseDouble(value, velocity);
+        } else if (key == "steps") {
+            ok = parseInt(value, steps);
+        } else if (key == "dt") {
+            ok = parseDouble(value, dt);
+        } else if (key == "outputSteps") {
+            ok = parseSteps(value, outputSteps);
+        } else if (key == "safetyFactor") {
+            ok = parseDouble(value, safetyFactor);
+        } else if (key == "subcycleLevels") {
+            ok = parseInt(value, subcycleLevels);
+        } else if (key == "loadSteps") {
+            ok = parseInt(value, convergence.loadSteps);
+        } else if (key == "forceTolerance") {
+            ok = parseDouble(value, convergence.forceTolerance);
+        } else if (key == "dispTolerance") {
+            ok = parseDouble(value, convergence.dispTolerance);
+        } else if (key == "stableSteps") {
+            ok = parseInt(value, convergence.stableSteps);
+        } else if (key == "cgTolerance") {
+            ok = parseDouble(value, cgTolerance);
+        } else if (key == "cgMaxIterations") {
+            ok = parseInt(value, cgMaxIterations);
+        } else if (key == "method") {
+            ok = parseMethod(value, method);
+        } else if (key == "integrator") {
+            ok = parseIntegrator(value, integrator);
+        } else if (key == "threads") {
+            int n = 0;  // 范围由 parseInt 检查, 超出 int 的值不会截断为正数
+            ok = parseInt(value, n) && n > 0;
+            threads = ok ? static_cast<size_t>(n) : threads;
+        } else if (key == "engine") {
+            ok = parseEngine(value, engine);
+        } else if (key == "precision") {
+            ok = parsePrecision(value, precision);
+        } else if (key == "reorder") {
+            ok = parseBool(value, reorder);
+        } else if (key == "compactEvery") {
+            ok = parseInt(value, compaction.interval);
+        } else if (key == "compactThreshold") {
+            ok = parseDouble(value, compaction.threshold);
+        } else if (key == "breakSubsteps") {
+            ok = parseInt(value, breakSubsteps);
+        } else if (key == "bondStorage") {
+            bondStorage = value;
+            ok = true;
+        } else if (key == "ranks") {
+            ok = parseInt(value, ranks);
+        } else {
+            return ERROR_NOT_SUPPORTED;
+        }
+        ASSERTER_WITH_INFO(ok, ERROR_INVALID_PARAMETER, "invalid value '%s' of '%s'", value.c_str(), name.c_str());
+        return NO_ERROR;
+    }
+
+    int SimConfig::validate() const
+    {
+        ASSERTER_WITH_INFO(dimension == 2 || dimension == 3, ERROR_INVALID_PARAMETER, "dimension must be 2 or 3");
+        ASSERTER_WITH_INFO(ndivx > 0 && ndivy > 0 && ndivz > 0 && nband > 0, ERROR_INVALID_PARAMETER,
+            "ndivx, ndivy, ndivz and nband must be positive");
+        ASSERTER_WITH_INFO(length > 0.0 && width > 0.0 && holeRadius >= 0.0, ERROR_INVALID_PARAMETER, "invalid plate geometry");
+        ASSERTER_WITH_INFO(horizon > 0.0 && nband >= static_cast<int>(horizon), ERROR_INVALID_PARAMETER,
+            "horizon must be positive and covered by the boundary bands");
+        ASSERTER_WITH_INFO(density > 0.0 && youngModulus > 0.0 && criticalStretch > 0.0, ERROR_INVALID_PARAMETER, "invalid material");
+        ASSERTER_WITH_INFO(steps > 0 && dt > 0.0, ERROR_INVALID_PARAMETER, "steps and dt must be positive");
+        ASSERTER_WITH_INFO(safetyFactor > 0.0 && safetyFactor <= 1.0, ERROR_INVALID_PARAMETER, "safetyFactor must be in (0, 1]");
+        ASSERTER_WITH_INFO(subcycleLevels >= 0 && subcycleLevels <= 8, ERROR_INVALID_PARAMETER, "subcycleLevels must be in [0, 8]");
+        ASSERTER_WITH_INFO(convergence.loadSteps >= 0 && convergence.loadSteps <= steps, ERROR_INVALID_PARAMETER,
+            "loadSteps must be in [0, steps]");
+        ASSERTER_WITH_INFO(convergence.forceTolerance >= 0.0 && convergence.dispTolerance >= 0.0 && convergence.stableSteps >= 0,
+            ERROR_INVALID_PARAMETER, "invalid convergence policy");
+        ASSERTER_WITH_INFO(cgTolerance > 0.0 && cgMaxIterations > 0, ERROR_INVALID_PARAMETER, "invalid PCG settings");
+        ASSERTER_WITH_INFO(threads > 0, ERROR_INVALID_PARAMETER, "threads must be positive");
+        ASSERTER_WITH_INFO(compaction.interval >= 0 && compaction.threshold >= 0.0, ERROR_INVALID_PARAMETER, "invalid compaction policy");
+        ASSERTER_WITH_INFO(breakSubsteps >= 0, ERROR_INVALID_PARAMETER, "breakSubsteps must not be negative");
+        ASSERTER_WITH_INFO(precision == PRECISION_FP64 || engine == FORCE_ENGINE_BOND, ERROR_INVALID_PARAMETER,
+            "mixed and fp32 precision require the bond engine");
+        // 点阵模板要求邻居列表按光栅顺序排列，重排后没有规则粒子
+        ASSERTER_WITH_INFO(!reorder || engine != FORCE_ENGINE_STENCIL, ERROR_INVALID_PARAMETER,
+            "particle reordering is not supported by the stencil engine");
+        // 半键模式的粒子对按全部粒子计算，不支持子循环
+        ASSERTER_WITH_INFO(subcycleLevels == 0 || engine != FORCE_ENGINE_HALF_BOND, ERROR_INVALID_PARAMETER,
+            "subcycling is not supported by the half-bond engine");
+        // 半键模式的粒子对按键编号索引，不支持断键压缩
+        ASSERTER_WITH_INFO((compaction.interval == 0 && compaction.threshold == 0.0) || engine != FORCE_ENGINE_HALF_BOND,
+            ERROR_INVALID_PARAMETER, "bond compaction is not supported by the half-bond engine");
+        // 半键模式不支持断键后的局部重算
+        ASSERTER_WITH_INFO(breakSubsteps == 0 || engine != FORCE_ENGINE_HALF_BOND, ERROR_INVALID_PARAMETER,
+            "break substeps are not supported by the half-bond engine");
+        // 加密层的单元边长为 dx * 2^refineLevels, 须整除板的各边
+        ASSERTER_WITH_INFO(refineLevels >= 0 && refineLevels <= 8 && refineWidth > 0.0, ERROR_INVALID_PARAMETER,
+            "refineLevels must be in [0, 8] and refineWidth positive");
+        const int cell = 1 << refineLevels;
+        ASSERTER_WITH_INFO(ndivx % cell == 0 && ndivy % cell == 0 && (dimension == 2 || ndivz % cell == 0), ERROR_INVALID_PARAMETER,
+            "ndivx, ndivy and ndivz must be multiples of 2^refineLevels");
+        // 三维、区域分解与变分辨率只支持 fp64 逐键计算的 ADR 松弛 (见 pd_solver.h)
+        const bool basicSolver = method == SOLVER_RELAXATION && integrator == INTEGRATOR_ADR && engine == FORCE_ENGINE_BOND
+            && precision == PRECISION_FP64 && !reorder && compaction.interval == 0 && compaction.threshold == 0.0
+            && convergence.loadSteps == 0 && convergence.forceTolerance == 0.0 && convergence.dispTolerance == 0.0
+            && breakSubsteps == 0;
+        ASSERTER_WITH_INFO(dimension == 2 || basicSolver,
+            ERROR_INVALID_PARAMETER, "the 3D solver supports only ADR relaxation with the fp64 bond engine");
+        ASSERTER_WITH_INFO(ranks > 0 && ranks <= ndivx, ERROR_INVALID_PARAMETER, "ranks must be in [1, ndivx]");
+        ASSERTER_WITH_INFO(ranks == 1 || basicSolver,
+            ERROR_INVALID_PARAMETER, "domain decomposition supports only ADR relaxation with the fp64 bond engine");
+        ASSERTER_WITH_INFO(refineLevels == 0 || basicSolver,
+            ERROR_INVALID_PARAMETER, "refinement supports only ADR relaxation with the fp64 bond engine");
+        // 粒子编号为 int, 键表偏移为 size_t
+        ASSERTER_WITH_INFO(maxParticles() < static_cast<size_t>(0x7fffffff), ERROR_INVALID_PARAMETER, "too many particles");
+        return NO_ERROR;
+    }
+
+} // namespace caep
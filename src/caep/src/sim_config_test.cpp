@@ -0,0 +1,156 @@
+#include <cstdio>
+#include <fstream>
+#include "sim_config.h"
+#include "gtest/gtest.h"
+
+
+TEST(SimConfig, SetByName)
+{
+    caep::SimConfig config;
+    EXPECT_EQ(config.validate(), NO_ERROR);
+
+    EXPECT_EQ(config.set("ndivx", "400"), NO_ERROR);
+    EXPECT_EQ(config.set("hole-radius", "0.01"), NO_ERROR);
+    EXPECT_EQ(config.set("outputSteps", "10,20"), NO_ERROR);
+    EXPECT_EQ(config.set("reorder", ""), NO_ERROR);
+    EXPECT_EQ(config.set("engine", "stencil"), NO_ERROR);
+    EXPECT_EQ(config.set("compact-every", "50"), NO_ERROR);
+    EXPECT_EQ(config.set("method", "pcg"), NO_ERROR);
+    EXPECT_EQ(config.set("cg-tolerance", "1e-6"), NO_ERROR);
+    EXPECT_EQ(config.set("integrator", "fire"), NO_ERROR);
+    EXPECT_EQ(config.ndivx, 400);
+    EXPECT_DOUBLE_EQ(config.holeRadius, 0.01);
+    ASSERT_EQ(config.outputSteps.size(), 2u);
+    EXPECT_EQ(config.outputSteps[1], 20);
+    EXPECT_TRUE(config.reorder);
+    EXPECT_EQ(config.engine, FORCE_ENGINE_STENCIL);
+    EXPECT_EQ(config.compaction.interval, 50);
+    EXPECT_EQ(config.method, SOLVER_PCG);
+    EXPECT_DOUBLE_EQ(config.cgTolerance, 1e-6);
+    EXPECT_EQ(config.integrator, INTEGRATOR_FIRE);
+
+    // 点阵模板不支持粒子重排
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("reorder", "false"), NO_ERROR);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+
+    EXPECT_EQ(config.set("unknown", "1"), ERROR_NOT_SUPPORTED);
+    EXPECT_EQ(config.set("ndivy", "abc"), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.ndivy, 100);
+    // 超出 int 范围的值不截断
+    EXPECT_EQ(config.set("ndivy", "4294967396"), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("steps", "99999999999999999999"), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.ndivy, 100);
+    EXPECT_EQ(config.set("threads", "4294967297"), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.threads, 1u);
+    EXPECT_EQ(config.set("precision", "fp16"), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("method", "newton"), ERROR_INVALID_PARAMETER);
+
+    EXPECT_EQ(config.set("safety-factor", "1.5"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("safety-factor", "0.5"), NO_ERROR);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+
+    // 混合精度只支持逐键计算
+    EXPECT_EQ(config.set("precision", "mixed"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("precision", "fp64"), NO_ERROR);
+
+    // 半键模式不支持断键压缩、子循环与断键子步
+    EXPECT_EQ(config.set("engine", "half-bond"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("compact-every", "0"), NO_ERROR);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+    EXPECT_EQ(config.set("compact-threshold", "0.1"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("compact-threshold", "0"), NO_ERROR);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+    EXPECT_EQ(config.set("subcycle-levels", "2"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("subcycle-levels", "0"), NO_ERROR);
+    EXPECT_EQ(config.set("break-substeps", "4"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("engine", "bond"), NO_ERROR);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+}
+
+TEST(SimConfig, Dimension)
+{
+    caep::SimConfig config;
+    EXPECT_EQ(config.set("dimension", "3"), NO_ERROR);
+    EXPECT_EQ(config.set("ndivz", "4"), NO_ERROR);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+    EXPECT_EQ(config.maxParticles(), 100u * 106u * 4u);
+
+    // 三维只支持 ADR 松弛与 fp64 逐键计算
+    EXPECT_EQ(config.set("method", "pcg"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(config.set("method", "relaxation"), NO_ERROR);
+    EXPECT_EQ(config.set("dimension", "4"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+}
+
+TEST(SimConfig, Ranks)
+{
+    caep::SimConfig config;
+    EXPECT_EQ(config.set("ranks", "4"), NO_ERROR);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+
+    // 区域分解只支持 ADR 松弛与 fp64 逐键计算
+    config.engine = FORCE_ENGINE_HALF_BOND;
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    config.engine = FORCE_ENGINE_BOND;
+    EXPECT_EQ(config.set("ranks", "0"), NO_ERROR);
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+}
+
+TEST(SimConfig, Refinement)
+{
+    caep::SimConfig config;
+    EXPECT_EQ(config.set("refine-levels", "2"), NO_ERROR);
+    EXPECT_EQ(config.set("refine-width", "0.004"), NO_ERROR);
+    EXPECT_EQ(config.refineWidth, 0.004);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+
+    // 最粗一层的单元须整除板的各边 (100 不是 8 的倍数)
+    config.refineLevels = 3;
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    config.refineLevels = 2;
+    config.precision = PRECISION_MIXED;
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+    config.precision = PRECISION_FP64;
+    config.refineWidth = 0.0;
+    EXPECT_EQ(config.validate(), ERROR_INVALID_PARAMETER);
+}
+
+TEST(SimConfig, LoadJson)
+{
+    const char* filename = "sim_config_test.json";
+    {
+        std::ofstream file(filename);
+        file << "{\"problem\": {\"ndivx\": 200, \"length\": 0.1},"
+                " \"time\": {\"steps\": 50, \"outputSteps\": [25, 50]},"
+                " \"convergence\": {\"loadSteps\": 5, \"forceTolerance\": 1e-4},"
+                " \"solver\": {\"precision\": \"fp32\", \"reorder\": true, \"compactThreshold\": 0.01}}";
+    }
+
+    caep::SimConfig config;
+    ASSERT_EQ(config.load(filename), NO_ERROR);
+    std::remove(filename);
+
+    EXPECT_EQ(config.ndivx, 200);
+    EXPECT_EQ(config.ndivy, 100);   // 未出现的项保持默认值
+    EXPECT_DOUBLE_EQ(config.length, 0.1);
+    EXPECT_EQ(config.steps, 50);
+    ASSERT_EQ(config.outputSteps.size(), 2u);
+    EXPECT_EQ(config.outputSteps[0], 25);
+    EXPECT_EQ(config.convergence.loadSteps, 5);
+    EXPECT_DOUBLE_EQ(config.convergence.forceTolerance, 1e-4);
+    EXPECT_EQ(config.convergence.stableSteps, 10);
+    EXPECT_EQ(config.precision, PRECISION_FP32);
+    EXPECT_TRUE(config.reorder);
+    EXPECT_DOUBLE_EQ(config.compaction.threshold, 0.01);
+    EXPECT_EQ(config.validate(), NO_ERROR);
+
+    EXPECT_NE(config.load("sim_config_test_missing.json"), NO_ERROR);
+}
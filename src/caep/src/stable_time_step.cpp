@@ -0,0 +1,36 @@
+#include <cmath>
+#include <limits>
+#include "stable_time_step.h"
+
+
+namespace caep {
+
+    template<typename Real>
+    void StableTimeStep::compute(const BasicBondKernelArgs<Real>& args, double density, double* dt, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            double stiffness = 0.0;
+            for (size_t b = args.offsets[i]; b < args.ends[i]; ++b) {
+                if (loadAliveBits(args.alive, b, 1) != 0) {
+                    stiffness += static_cast<double>(args.coef[b]) / args.idist[b];
+                }
+            }
+            dt[i] = stiffness > 0.0 ? std::sqrt(2.0 * density / stiffness) : std::numeric_limits<double>::infinity();
+        }
+    }
+
+    void StableTimeStep::levels(const double* dt, double minDt, int maxLevel, uint8_t* level, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i) {
+            int l = 0;
+            while (l < maxLevel && dt[i] >= minDt * static_cast<double>(2 << l)) {
+                ++l;
+            }
+            level[i] = static_cast<uint8_t>(l);
+        }
+    }
+
+    template void StableTimeStep::compute<float>(const BasicBondKernelArgs<float>&, double, double*, int, int);
+    template void StableTimeStep::compute<double>(const BasicBondKernelArgs<double>&, double, double*, int, int);
+
+} // namespace caep
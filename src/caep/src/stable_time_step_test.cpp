@@ -0,0 +1,40 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "stable_time_step.h"
+#include "gtest/gtest.h"
+
+
+TEST(StableTimeStep, Compute)
+{
+    // 粒子 0: 两根键 (coef / idist = 1 + 3), 粒子 1: 一根有效键 (第二根已断), 粒子 2: 没有键
+    std::vector<size_t> offsets = {0, 2, 4}, ends = {2, 4, 4};
+    std::vector<int> neighbors = {1, 2, 0, 2};
+    std::vector<uint64_t> alive = {0x7};
+    std::vector<double> idist = {1.0, 0.5, 2.0, 1.0}, coef = {1.0, 1.5, 4.0, 1.0};
+
+    caep::BondKernelArgs args = caep::BondKernelArgs();
+    args.offsets = offsets.data();
+    args.ends = ends.data();
+    args.neighbors = neighbors.data();
+    args.alive = alive.data();
+    args.idist = idist.data();
+    args.coef = coef.data();
+
+    std::vector<double> dt(3);
+    caep::StableTimeStep::compute(args, 8.0, dt.data(), 0, 3);
+    EXPECT_DOUBLE_EQ(dt[0], std::sqrt(2.0 * 8.0 / 4.0));
+    EXPECT_DOUBLE_EQ(dt[1], std::sqrt(2.0 * 8.0 / 2.0));
+    EXPECT_EQ(dt[2], std::numeric_limits<double>::infinity());
+
+    std::vector<uint8_t> level(3);
+    caep::StableTimeStep::levels(dt.data(), dt[0], 0, level.data(), 0, 3);
+    EXPECT_EQ(level[1], 0);
+    caep::StableTimeStep::levels(dt.data(), dt[0], 3, level.data(), 0, 3);
+    EXPECT_EQ(level[0], 0);
+    EXPECT_EQ(level[1], 0);     // dt[1] / dt[0] = sqrt(2)
+    EXPECT_EQ(level[2], 3);     // 最大层级
+    caep::StableTimeStep::levels(dt.data(), 0.5 * dt[0], 3, level.data(), 0, 3);
+    EXPECT_EQ(level[0], 1);
+    EXPECT_EQ(level[1], 1);
+}
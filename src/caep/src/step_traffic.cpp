@@ -0,0 +1,28 @@
+#include "step_traffic.h"
+
+
+namespace caep {
+
+    void StepTraffic::addPass(const std::string& name, size_t count, double bytesPerItem)
+    {
+        mPasses.push_back({name, static_cast<size_t>(count * bytesPerItem)});
+    }
+
+    void StepTraffic::addToPass(size_t count, double bytesPerItem)
+    {
+        if (mPasses.empty()) {
+            mPasses.push_back({"", 0});
+        }
+        mPasses.back().bytes += static_cast<size_t>(count * bytesPerItem);
+    }
+
+    size_t StepTraffic::bytes() const
+    {
+        size_t total = 0;
+        for (const Pass& pass : mPasses) {
+            total += pass.bytes;
+        }
+        return total;
+    }
+
+} // namespace caep
@@ -0,0 +1,69 @@
+#include <cmath>
+#include "surface_correction.h"
+#include "bond_geometry.h"
+#include "dual_horizon.h"
+#include "xthread_flow.h"
+#include "logger.h"
+
+
+namespace caep {
+
+    namespace {
+
+        void computeRange(const BondTable& bonds, const std::vector<const double*>& coords,
+            const SurfaceCorrection::Params& params, std::vector<std::vector<double>>& factors, int begin, int end)
+        {
+            const size_t dims = coords.size();
+            const double grow = (1.0 + params.strain) * (1.0 + params.strain) - 1.0; // 拉伸方向分量平方的增量系数
+            std::vector<double> xi(dims), energy(dims);
+
+            for (int i = begin; i < end; ++i) {
+                energy.assign(dims, 0.0);
+                for (size_t b = bonds.begin(i); b < bonds.end(i); ++b) {
+                    int j = bonds.neighbor(b);
+                    double length2 = 0.0;
+                    for (size_t d = 0; d < dims; ++d) {
+                        xi[d] = coords[d][j] - coords[d][i];
+                        length2 += xi[d] * xi[d];
+                    }
+                    double idist = std::sqrt(length2);
+                    double weight = 0.0;
+                    if (params.dual != nullptr) {
+                        weight = 0.25 * idist * params.dual->stiffness(i, j, idist);
+                    } else {
+                        double fac = BondGeometry::volumeCorrection(idist, params.delta, params.dx);
+                        weight = 0.25 * params.bc * idist * params.vol * fac;
+                    }
+                    for (size_t d = 0; d < dims; ++d) {
+                        double stretch = (std::sqrt(length2 + grow * xi[d] * xi[d]) - idist) / idist;
+                        energy[d] += weight * stretch * stretch;
+                    }
+                }
+                for (size_t d = 0; d < dims; ++d) {
+                    factors[d][i] = energy[d] > 0.0 ? params.sedload / energy[d] : 1.0;
+                }
+            }
+        }
+
+    } // namespace
+
+    int SurfaceCorrection::compute(const BondTable& bonds, const std::vector<const double*>& coords, int numParticles,
+        const Params& params, size_t tile, std::vector<std::vector<double>>& factors)
+    {
+        ASSERTER_WITH_RET(!coords.empty() && numParticles >= 0, ERROR_INVALID_PARAMETER);
+        ASSERTER_WITH_RET(static_cast<size_t>(numParticles) <= bonds.numParticles(), ERROR_INVALID_PARAMETER);
+
+        factors.assign(coords.size(), std::vector<double>(numParticles, 1.0));
+        if (tile == 0) {
+            computeRange(bonds, coords, params, factors, 0, numParticles);
+            return NO_ERROR;
+        }
+
+        XTHREAD_PARALLELIZE_TILED_TASK_QUOTE(numParticles, tile)
+            computeRange(bonds, coords, params, factors, static_cast<int>(_i), static_cast<int>(_i + _ti));
+        XTHREAD_PARALLELIZE_END
+
+        return NO_ERROR;
+    }
+
+} // namespace caep
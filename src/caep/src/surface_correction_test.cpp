@@ -0,0 +1,75 @@
+#include <cmath>
+#include <vector>
+#include "surface_correction.h"
+#include "neighbor_search.h"
+#include "xthread_flow.h"
+#include "gtest/gtest.h"
+
+
+namespace {
+
+    // n x n 的方形粒子网格 (间距 1), 末尾加一个远离网格的孤立粒子
+    struct Grid {
+        std::vector<caep::Vec2>     points;
+        std::vector<double>         x, y;
+        caep::BondTable             bonds;
+
+        Grid(int n, double delta)
+        {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    points.push_back({static_cast<double>(j), static_cast<double>(i)});
+                }
+            }
+            points.push_back({100.0, 100.0});
+            for (const caep::Vec2& p : points) {
+                x.push_back(p.x);
+                y.push_back(p.y);
+            }
+            std::vector<int> numfam, pointfam, nodefam;
+            EXPECT_EQ(caep::NeighborSearch::buildByCellList(points, delta, numfam, pointfam, nodefam), NO_ERROR);
+            EXPECT_EQ(bonds.init(numfam, std::move(nodefam)), NO_ERROR);
+        }
+    };
+
+} // namespace
+
+TEST(SurfaceCorrection, Factors)
+{
+    const int n = 15;
+    const double delta = 3.015;
+    Grid grid(n, delta);
+    const int total = static_cast<int>(grid.points.size());
+    caep::SurfaceCorrection::Params params = {delta, 1.0, 1.0, 1.0, 1e-3, 1e-6, nullptr};
+
+    std::vector<std::vector<double>> serial;
+    ASSERT_EQ(caep::SurfaceCorrection::compute(grid.bonds, {grid.x.data(), grid.y.data()}, total, params, 0, serial),
+        NO_ERROR);
+    ASSERT_EQ(serial.size(), 2u);
+
+    // 内部粒子 (离边界超过作用域) 的修正因子相同, x 与 y 方向对称
+    const int center = (n / 2) * n + n / 2, inner = 4 * n + 4;
+    EXPECT_DOUBLE_EQ(serial[0][center], serial[0][inner]);
+    EXPECT_NEAR(serial[0][center], serial[1][center], 1e-12 * serial[0][center]);
+
+    // 边界粒子缺少邻居, 应变能偏小, 修正因子大于内部粒子
+    EXPECT_GT(serial[0][0], serial[0][center]);
+    EXPECT_GT(serial[1][n - 1], serial[1][center]);
+
+    // 孤立粒子没有键, 不修正
+    EXPECT_DOUBLE_EQ(serial[0][total - 1], 1.0);
+    EXPECT_DOUBLE_EQ(serial[1][total - 1], 1.0);
+
+    // 并行分块计算与串行结果逐位一致
+    framework::Flow& flow = framework::Flow::get();
+    flow.deinit();
+    ASSERT_EQ(flow.init(3, 1), NO_ERROR);
+    std::vector<std::vector<double>> parallel;
+    ASSERT_EQ(caep::SurfaceCorrection::compute(grid.bonds, {grid.x.data(), grid.y.data()}, total, params, 16, parallel),
+        NO_ERROR);
+    flow.deinit();
+    for (int i = 0; i < total; ++i) {
+        EXPECT_EQ(parallel[0][i], serial[0][i]);
+        EXPECT_EQ(parallel[1][i], serial[1][i]);
+    }
+}
@@ -1,5 +1,12 @@
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <utility>
 #include "gtest/gtest.h"
 #include "caep.h"
+#include "sim_config.h"
+#include "argument_parser.h"
 
 #define TAG_LOGGER "[CAEP]"
 #include "logger.h"
@@ -15,6 +22,23 @@ void showTitle()
     LOGGER_I("************************************************\n\n");
 }
 
+// parses a non-negative count, an empty value selects defaultValue
+bool parseCount(const std::string& value, size_t defaultValue, size_t& out)
+{
+    if (value.empty()) {
+        out = defaultValue;
+        return true;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long v = std::strtoull(value.c_str(), &end, 10);
+    if (value[0] == '-' || *end != '\0' || errno == ERANGE) {
+        return false;
+    }
+    out = static_cast<size_t>(v);
+    return true;
+}
+
 int main(int argc, char **argv)
 {
     showTitle();
@@ -23,9 +47,85 @@ int main(int argc, char **argv)
     int retGTest = RUN_ALL_TESTS();
     ASSERTER_WITH_RET(retGTest == NO_ERROR, retGTest);
 
+    // options: --config FILE (json, see sim_config.h), -t/--threads N, --scaling N (strong scaling from 1 to N threads),
+    //          --engine bond|half-bond|stencil, --reorder (morton particle order), --bench-reorder N (bond loop throughput up to N particles),
+    //          --compact-every K, --compact-threshold F (move broken bonds out of the bond loop),
+    //          --break-substeps N (bonds take effect within the step, up to N local relaxation substeps),
+    //          --precision fp64|mixed|fp32, --precision-report (accuracy of mixed and fp32 against fp64),
+    //          --method relaxation|pcg|dynamic (pseudo-time relaxation, quasi-static load steps solved with PCG,
+    //          or explicit dynamics with the critical time step scaled by --safety-factor, --subcycle-levels L),
+    //          --integrator adr|fire (relaxation integrator),
+    //          --dimension 3 --ndivz N (3D thick plate with N layers, ADR relaxation with the fp64 bond engine),
+    //          --bond-storage DIR (keep the bond table in memory-mapped files under DIR, for problems larger than RAM),
+    //          --ranks N (domain decomposition over N local processes exchanging ghost layers in shared memory),
+    //          --refine-levels L --refine-width W (particle spacing doubles L times away from the hole, dual-horizon bonds),
+    //          and any other config item by name, e.g. --ndivx 1000 --ndivy 1000 --steps 200 --output-steps 100,200
+    // items given on the command line override the config file
+    std::string configFile;
+    std::vector<std::pair<std::string, std::string>> overrides;
+    size_t scaling = 0;
+    size_t benchReorder = 0;
+    bool precisionReport = false;
+    util::ArgumentParser parser(
+        [&](char optionShort, const std::string& optionLong, util::ArgumentParser::ValueOption& valueOption) {
+            if (optionShort == 't') {
+                overrides.emplace_back("threads", valueOption.get());
+            } else if (optionLong == "config") {
+                configFile = valueOption.get();
+            } else if (optionLong == "precision-report") {
+                precisionReport = true;
+            } else if (optionLong == "bench-reorder") {
+                if (!parseCount(valueOption.get(), 10000000, benchReorder)) {
+                    LOGGER_E("invalid value '%s' for option '--bench-reorder'\n", valueOption.get().c_str());
+                    return false;
+                }
+            } else if (optionLong == "scaling") {
+                if (!parseCount(valueOption.get(), 64, scaling)) {
+                    LOGGER_E("invalid value '%s' for option '--scaling'\n", valueOption.get().c_str());
+                    return false;
+                }
+            } else if (!optionLong.empty()) {
+                overrides.emplace_back(optionLong, valueOption.get());
+            } else {
+                LOGGER_E("invalid option '-%c'\n", optionShort);
+                return false;
+            }
+            return true;
+        }
+    );
+    ASSERTER_WITH_RET(parser.parse(argc, argv), ERROR_INVALID_PARAMETER);
+
+    caep::SimConfig config;
+    if (!configFile.empty()) {
+        int retLoad = config.load(configFile);
+        ASSERTER_WITH_RET(retLoad == NO_ERROR, retLoad);
+    }
+    for (const auto& item : overrides) {
+        int retSet = config.set(item.first, item.second);
+        ASSERTER_WITH_INFO(retSet != ERROR_NOT_SUPPORTED, retSet, "invalid option '--%s'", item.first.c_str());
+        ASSERTER_WITH_RET(retSet == NO_ERROR, retSet);
+    }
     // caep
-    int retDemoHole = demo_hole();
+    if (scaling > 0) {
+        int retScaling = scaling_hole(config, scaling);
+        ASSERTER_WITH_RET(retScaling == NO_ERROR, retScaling);
+        return NO_ERROR;
+    }
+
+    if (precisionReport) {
+        int retPrecision = precision_hole(config);
+        ASSERTER_WITH_RET(retPrecision == NO_ERROR, retPrecision);
+        return NO_ERROR;
+    }
+
+    if (benchReorder > 0) {
+        int retBench = bench_reorder(benchReorder);
+        ASSERTER_WITH_RET(retBench == NO_ERROR, retBench);
+        return NO_ERROR;
+    }
+
+    int retDemoHole = demo_hole(config);
     ASSERTER_WITH_RET(retDemoHole == NO_ERROR, retDemoHole);
 
     return NO_ERROR;
-}
\ No newline at end of file
+}